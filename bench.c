@@ -1,34 +1,49 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "bench.h"
 #include "timer.h"
 #include "perft_table_entries.h"
 #include "chess_search.h"
+#include "transposition_table.h"
 #include "board_info.h"
 #include "game_state.h"
 #include "zobrist.h"
 #include "FEN.h"
+#include "util_macros.h"
 
 bool Bench(int argc, char** argv) {
-    if(argc != 2 || strcmp(argv[1], "bench")) {
+    if(argc < 2 || strcmp(argv[1], "bench")) {
         return true; // keep running
     }
 
+    int threads = (argc > 2) ? atoi(argv[2]) : threads_default;
+    CLAMP_TO_RANGE(threads, threads_min, threads_max);
+
     FEN_t fenList[] = { PERFT_TEST_TABLE(EXPAND_AS_FEN_ARRAY) };
     BoardInfo_t boardInfo;
     GameStack_t gameStack;
     ZobristStack_t zobristStack;
 
+    // the TT carries over from one position to the next, so start from the same empty one every time
+    TTClear();
+
     Stopwatch_t stopwatch;
     StopwatchInit(&stopwatch);
     NodeCount_t nodeCount = 0;
     for(int i = 0; i < NUM_PERFT_ENTRIES; i++) {
         InterpretFEN(fenList[i], &boardInfo, &gameStack, &zobristStack);
-        nodeCount += BenchSearch(&boardInfo, &gameStack, &zobristStack, 5);
+        nodeCount += BenchSearch(&boardInfo, &gameStack, &zobristStack, 5, threads);
     }
 
     Milliseconds_t msec = ElapsedTime(&stopwatch);
+    if(msec == 0) {
+        msec = 1;
+    }
+
+    // the node count is the bench signature, it's the same on every machine as long as it's searched with one thread
+    printf("%d threads %lld ms\n", threads, (long long)msec);
     printf("%lld nodes %lld nps\n", (long long)nodeCount, (long long)(nodeCount * msec_per_sec) / msec);
 
     return false;
@@ -12,6 +12,8 @@
 #include "UCI.h"
 #include "bench.h"
 #include "chess_search.h"
+#include "transposition_table.h"
+#include "NNUE.h"
 
 int main(int argc, char** argv)
 {
@@ -19,11 +21,14 @@ int main(int argc, char** argv)
 
     InitLookupTables();
     GenerateZobristKeys();
+    NNUEInit();
+    TTInit();
+    InitSearchTables();
 
     bool running = Bench(argc, argv);
 
     UciApplicationData_t uciApplicationData;
-    UciSearchInfoInit(&uciApplicationData.uciSearchInfo);
+    UciApplicationDataInit(&uciApplicationData);
     while(running)
     {
         running = InterpretUCIInput(&uciApplicationData);
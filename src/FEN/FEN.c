@@ -3,6 +3,7 @@
 
 #include "FEN.h"
 #include "movegen.h"
+#include "evaluation.h"
 
 static double usr_pow(int x, int y) {
     double result = 1;
@@ -198,6 +199,7 @@ void InterpretFEN(
     UpdateAllPieces(info);
     UpdateEmpty(info);
     TranslateBitboardsToMailbox(info);
+    InitMaterialAndPST(info);
 
     i++;
     info->colorToMove = CharToColor(fen[i]);
@@ -220,7 +222,11 @@ void InterpretFEN(
     i++;
     UpdateHalfmoveClock(fen, i, gameState);
 
+#ifndef UNDO_UNMAKE
     gameState->boardInfo = *info;
+#endif
+    gameState->hash = HashPosition(info, gameStack);
+    gameState->pawnHash = HashPawnStructure(info);
 
-    AddZobristHashToStack(zobristStack, HashPosition(info, gameStack));
+    AddZobristHashToStack(zobristStack, gameState->hash);
 }
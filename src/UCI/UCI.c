@@ -11,6 +11,9 @@
 #include "make_and_unmake.h"
 #include "time_constants.h"
 #include "util_macros.h"
+#include "transposition_table.h"
+#include "evaluation.h"
+#include "NNUE.h"
 
 #define BUFFER_SIZE 50000
 
@@ -21,8 +24,16 @@
 // UCI Options
 #define OVERHEAD "Overhead"
 #define HASH "Hash"
+#define THREADS "Threads"
+#define USE_NNUE "UseNNUE"
+#define EVAL_FILE "EvalFile"
+#define MULTIPV "MultiPV"
+#define PONDER "Ponder"
+
+#define EMBEDDED_NETWORK "<embedded>"
 
 #define BESTMOVE "bestmove"
+#define PONDER_MOVE "ponder"
 
 #define STARTPOS "startpos"
 
@@ -35,7 +46,9 @@ enum {
     signal_new_game,
     signal_position,
     signal_go,
-    signal_setoption
+    signal_stop,
+    signal_setoption,
+    signal_ponderhit
 };
 
 static char RowToNumberChar(int row) {
@@ -190,8 +203,12 @@ static UciSignal_t InterpretWord(const char* word) {
         return signal_position;
     } else if(StringsMatch(word, "go")) {
         return signal_go;
+    } else if(StringsMatch(word, "stop")) {
+        return signal_stop;
     } else if (StringsMatch(word, "setoption")) {
         return signal_setoption;
+    } else if(StringsMatch(word, "ponderhit")) {
+        return signal_ponderhit;
     }
 
     return signal_invalid;
@@ -235,7 +252,7 @@ static void ParseAndPlayMoves(
         InitMove(&move);
         if(UCITranslateMove(&move, moveBuffer, boardInfo, gameStack)) {
             MakeMove(boardInfo, gameStack, move);
-            AddZobristHashToStack(zobristStack, HashPosition(boardInfo, gameStack));
+            AddZobristHashToStack(zobristStack, ReadZobristHash(gameStack));
         }
     }
 }
@@ -299,8 +316,37 @@ static void GetSearchResults(UciSearchInfo_t* uciSearchInfo, UciApplicationData_
     char moveString[BUFFER_SIZE];
     MoveStructToUciString(searchResults.bestMove, moveString, BUFFER_SIZE);
 
-    printf(BESTMOVE);
-    printf(" %s\n", moveString);
+    if(uciSearchInfo->ponderEnabled && searchResults.ponderMove.data != 0) {
+        char ponderString[BUFFER_SIZE];
+        MoveStructToUciString(searchResults.ponderMove, ponderString, BUFFER_SIZE);
+        printf(BESTMOVE " %s " PONDER_MOVE " %s\n", moveString, ponderString);
+    } else {
+        printf(BESTMOVE " %s\n", moveString);
+    }
+}
+
+static void* SearchThreadMain(void* arg) {
+    UciApplicationData_t* applicationData = arg;
+    GetSearchResults(&applicationData->uciSearchInfo, applicationData);
+    return NULL;
+}
+
+static void StartSearchThread(UciApplicationData_t* applicationData) {
+    applicationData->searchRunning = true;
+    pthread_create(&applicationData->searchThread, NULL, SearchThreadMain, applicationData);
+}
+
+// anything that touches the position or the options has to wait until the search is done with them
+static void WaitForSearchThread(UciApplicationData_t* applicationData) {
+    if(applicationData->searchRunning) {
+        pthread_join(applicationData->searchThread, NULL);
+        applicationData->searchRunning = false;
+    }
+}
+
+static void StopSearchThread(UciApplicationData_t* applicationData) {
+    atomic_store(&applicationData->uciSearchInfo.stopSignal, true);
+    WaitForSearchThread(applicationData);
 }
 
 void InterpretGoArguements(char input[BUFFER_SIZE], int* i, UciSearchInfo_t* searchInfo) {
@@ -328,17 +374,23 @@ void InterpretGoArguements(char input[BUFFER_SIZE], int* i, UciSearchInfo_t* sea
             searchInfo->bInc = NumberStringToNumber(nextWord);    
 
         } else if(StringsMatch(nextWord, "infinite")) {
-            searchInfo->wTime = MSEC_MAX;       
-            searchInfo->bTime = MSEC_MAX;
+            searchInfo->infinite = true;
+
+        } else if(StringsMatch(nextWord, "ponder")) {
+            // the clock arguments that come with it are for after the ponderhit
+            atomic_store(&searchInfo->pondering, true);
 
         } else if(StringsMatch(nextWord, "depth")) {
             GetNextWord(input, nextWord, i);
             searchInfo->depthLimit = NumberStringToNumber(nextWord);
 
-            if(searchInfo->wTime == 0 || !searchInfo->bTime == 0) {
-                searchInfo->wTime = MSEC_MAX;       
-                searchInfo->bTime = MSEC_MAX;
-            }
+        } else if(StringsMatch(nextWord, "nodes")) {
+            GetNextWord(input, nextWord, i);
+            searchInfo->nodeLimit = strtoull(nextWord, NULL, 10);
+
+        } else if(StringsMatch(nextWord, "movestogo")) {
+            GetNextWord(input, nextWord, i);
+            searchInfo->movesToGo = NumberStringToNumber(nextWord);
 
         } else if(StringsMatch(nextWord, "movetime")) {
             GetNextWord(input, nextWord, i);       
@@ -357,6 +409,12 @@ do { \
 static void UciSignalResponse() {
     printf(ENGINE_ID);
     SendUciOption(OVERHEAD, "spin", "default %d min %d max %d", overhead_default_msec, overhead_min_msec, overhead_max_msec);
+    SendUciOption(HASH, "spin", "default %d min %d max %d", hash_default_mb, hash_min_mb, hash_max_mb);
+    SendUciOption(THREADS, "spin", "default %d min %d max %d", threads_default, threads_min, threads_max);
+    SendUciOption(PONDER, "check", "default %s", "false");
+    SendUciOption(MULTIPV, "spin", "default %d min %d max %d", multipv_default, multipv_min, multipv_max);
+    SendUciOption(USE_NNUE, "check", "default %s", "false");
+    SendUciOption(EVAL_FILE, "string", "default %s", EMBEDDED_NETWORK);
     printf(UCI_OK);
 }
 
@@ -375,6 +433,44 @@ static void SetOption(char input[BUFFER_SIZE], int* i, UciSearchInfo_t* searchIn
         GetNextWord(input, nextWord, i);
         searchInfo->overhead = NumberStringToNumber(nextWord);
         CLAMP_TO_RANGE(searchInfo->overhead, overhead_min_msec, overhead_max_msec);
+    } else if(StringsMatch(nextWord, HASH)) {
+        SkipNextWord(input, i);
+
+        GetNextWord(input, nextWord, i);
+        Megabytes_t hashSize = NumberStringToNumber(nextWord);
+        CLAMP_TO_RANGE(hashSize, hash_min_mb, hash_max_mb);
+        TTResize(hashSize);
+    } else if(StringsMatch(nextWord, THREADS)) {
+        SkipNextWord(input, i);
+
+        GetNextWord(input, nextWord, i);
+        searchInfo->threads = NumberStringToNumber(nextWord);
+        CLAMP_TO_RANGE(searchInfo->threads, threads_min, threads_max);
+    } else if(StringsMatch(nextWord, PONDER)) {
+        SkipNextWord(input, i);
+
+        GetNextWord(input, nextWord, i);
+        searchInfo->ponderEnabled = StringsMatch(nextWord, "true");
+    } else if(StringsMatch(nextWord, MULTIPV)) {
+        SkipNextWord(input, i);
+
+        GetNextWord(input, nextWord, i);
+        searchInfo->multiPv = NumberStringToNumber(nextWord);
+        CLAMP_TO_RANGE(searchInfo->multiPv, multipv_min, multipv_max);
+    } else if(StringsMatch(nextWord, USE_NNUE)) {
+        SkipNextWord(input, i);
+
+        GetNextWord(input, nextWord, i);
+        UseNNUE(StringsMatch(nextWord, "true"));
+    } else if(StringsMatch(nextWord, EVAL_FILE)) {
+        SkipNextWord(input, i);
+
+        GetNextWord(input, nextWord, i);
+        if(StringsMatch(nextWord, EMBEDDED_NETWORK)) {
+            NNUEUseEmbeddedNetwork();
+        } else if(!NNUELoadNetwork(nextWord)) {
+            printf("info string failed to load network %s, keeping the current one\n", nextWord);
+        }
     }
 }
 
@@ -393,11 +489,14 @@ static bool RespondToSignal(
         printf(READY_OK);
         break;
     case signal_quit:
+        StopSearchThread(applicationData);
         return false;
     case signal_new_game:
-        // TODO
+        WaitForSearchThread(applicationData);
+        TTClear();
         break;
     case signal_position:
+        WaitForSearchThread(applicationData);
         InterpretPosition(
             input,
             i,
@@ -407,10 +506,19 @@ static bool RespondToSignal(
         );
         break;
     case signal_go:
+        WaitForSearchThread(applicationData);
         InterpretGoArguements(input, i, &applicationData->uciSearchInfo);
-        GetSearchResults(&applicationData->uciSearchInfo, applicationData);
-        break;   
+        StartSearchThread(applicationData);
+        break;
+    case signal_stop:
+        StopSearchThread(applicationData);
+        break;
+    case signal_ponderhit:
+        // the opponent played the expected move, so the search just starts minding the clock
+        atomic_store(&applicationData->uciSearchInfo.pondering, false);
+        break;
     case signal_setoption:
+        WaitForSearchThread(applicationData);
         SetOption(input, i, &applicationData->uciSearchInfo);
         break;  
     default:
@@ -425,7 +533,15 @@ bool InterpretUCIInput(UciApplicationData_t* applicationData)
     char input[BUFFER_SIZE];
     memset(input, '\0', BUFFER_SIZE* sizeof(char));
     if(fgets(input, BUFFER_SIZE, stdin) == NULL) {
-        return true;
+        // input closed, let any running search report its move and then shut down.
+        // Ponder and infinite searches would wait for a GUI that's gone, so those are stopped
+        UciSearchInfo_t* uciSearchInfo = &applicationData->uciSearchInfo;
+        if(uciSearchInfo->infinite || atomic_load(&uciSearchInfo->pondering)) {
+            StopSearchThread(applicationData);
+        } else {
+            WaitForSearchThread(applicationData);
+        }
+        return false;
     }
 
     char currentWord[BUFFER_SIZE];
@@ -451,14 +567,11 @@ void InterpretUCIString(
     const char* _input
 )
 {
-    UciSearchInfo_t searchInfo;
-    UciSearchInfoInit(&searchInfo);
-
     UciApplicationData_t data;
+    UciApplicationDataInit(&data);
     data.boardInfo = *boardInfo;
     data.gameStack = *gameStack;
     data.zobristStack = *zobristStack;
-    data.uciSearchInfo = searchInfo;
 
     char input[BUFFER_SIZE];
     memset(input, '\0', BUFFER_SIZE* sizeof(char));
@@ -477,21 +590,30 @@ void InterpretUCIString(
         }
     }
 
+    WaitForSearchThread(&data);
+
     *boardInfo = data.boardInfo;
     *gameStack = data.gameStack;
     *zobristStack = data.zobristStack;
 }
 
-void SendPvInfo(PvTable_t* pvTable, Depth_t depth) {
-    PvLength_t variationLength = pvTable->pvLength[0];
-    printf("info depth %d pv", depth);
+void UciApplicationDataInit(UciApplicationData_t* applicationData) {
+    InterpretFEN(START_FEN, &applicationData->boardInfo, &applicationData->gameStack, &applicationData->zobristStack);
+    UciSearchInfoInit(&applicationData->uciSearchInfo);
+    applicationData->searchRunning = false;
+}
 
-    char moveString[6];
-    for(int i = 0; i < variationLength; i++) {
-        Move_t move = pvTable->moveMatrix[0][i];
-        MoveStructToUciString(move, moveString, 6);
-        printf(" %s", moveString);
+void WritePvString(char pvString[PV_STRING_MAX], Move_t* pv, PvLength_t pvLength) {
+    pvString[0] = '\0';
+    if(pvLength == 0) {
+        return;
     }
 
-    printf("\n");
+    char moveString[6];
+    strcat(pvString, " pv");
+    for(int i = 0; i < pvLength; i++) {
+        MoveStructToUciString(pv[i], moveString, 6);
+        strcat(pvString, " ");
+        strcat(pvString, moveString);
+    }
 }
\ No newline at end of file
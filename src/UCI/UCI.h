@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <pthread.h>
 
 #include "move.h"
 #include "board_info.h"
@@ -18,8 +19,13 @@ typedef struct
     GameStack_t gameStack;
     ZobristStack_t zobristStack;
     UciSearchInfo_t uciSearchInfo;
+
+    pthread_t searchThread;
+    bool searchRunning;
 } UciApplicationData_t;
 
+void UciApplicationDataInit(UciApplicationData_t* applicationData);
+
 bool UCITranslateMove(Move_t* move, const char* moveText, BoardInfo_t* boardInfo, GameStack_t* gameStack);
 
 bool InterpretUCIInput(UciApplicationData_t* applicationData);
@@ -31,13 +37,14 @@ void InterpretUCIString(
     const char* _input
 );
 
-void SendPvInfo(PvTable_t* pvTable, Depth_t depth);
+// room for a space and up to 5 characters per move
+#define PV_STRING_MAX (PLY_MAX * 6 + 1)
+
+// writes " pv <moves>", or nothing for an empty PV, so it can go at the end of an info line
+void WritePvString(char pvString[PV_STRING_MAX], Move_t* pv, PvLength_t pvLength);
 
+// single printf so lines from the search thread never interleave with responses from the input thread
 #define SendUciInfoString(formatString, ...) \
-do { \
-    printf("info "); \
-    printf(formatString, __VA_ARGS__); \
-    printf("\n"); \
-} while(0)
+    printf("info " formatString "\n", __VA_ARGS__)
 
 #endif
\ No newline at end of file
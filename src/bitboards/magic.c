@@ -3,6 +3,13 @@
 #include <stdbool.h>
 #include <assert.h>
 
+// PEXT needs x86-64 and a compiler that can build a single function for BMI2 without the whole file requiring it
+#if defined(__GNUC__) && defined(__x86_64__)
+#define PEXT_BACKEND
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 #include "magic.h"
 #include "magic_table.h"
 #include "bitboards.h"
@@ -12,6 +19,19 @@ enum {
     uninitialized = 0xffffffffffffffff
 };
 
+enum {
+    cpuid_features_leaf = 1,
+    cpuid_extended_features_leaf = 7,
+    cpuid_bmi2_bit = 1 << 8,
+    amd_fast_pext_family = 0x19 // Zen 3, everything before it runs PEXT in microcode
+};
+
+// how a blocker set is turned into an index into the square's slice of the table
+typedef enum {
+    magic_indexing,
+    pext_indexing
+} Indexing_t;
+
 typedef uint32_t Hash_t;
 
 typedef Bitboard_t (*BlockersToAttacksCallback_t)(Square_t, Bitboard_t);
@@ -36,6 +56,27 @@ static int DistinctBlockers(int n) {
 
 Hash_t MagicHash(Bitboard_t blockers, MagicBB_t magic, uint8_t shift) { return (blockers * magic) >> shift; }
 
+// same index the PEXT instruction gives, only used to fill the table so it works on any CPU
+static Hash_t SoftwarePext(Bitboard_t blockers, Bitboard_t mask) {
+    Hash_t result = 0;
+    for(Hash_t bit = 1; mask; bit <<= 1) {
+        if(blockers & mask & -mask) {
+            result |= bit;
+        }
+        mask &= mask - 1;
+    }
+
+    return result;
+}
+
+static Hash_t TableIndex(Indexing_t indexing, Bitboard_t blockers, MagicEntry_t* entry) {
+    if(indexing == pext_indexing) {
+        return SoftwarePext(blockers, entry->mask);
+    }
+
+    return MagicHash(blockers, entry->magic, entry->shift);
+}
+
 static void InitHashTable(Bitboard_t* hashTable, int tableEntries) {
     for(int i = 0; i < tableEntries; i++) {
         hashTable[i] = uninitialized;
@@ -126,17 +167,16 @@ static void InitTempStorage(
 }
 
 static void FillHashTable(
-    MagicBB_t magic,
+    MagicEntry_t* entry,
     Bitboard_t* hashTable,
-    uint32_t offset,
-    uint8_t shift,
-    Bitboard_t mask,
+    Indexing_t indexing,
     Square_t square,
     BlockersToAttacksCallback_t callback
 )
 {
     assert(hashTable != NULL);
-    uint8_t indexBits = 64-shift;
+    uint32_t offset = entry->offset;
+    uint8_t indexBits = 64 - entry->shift;
     int tableEntries = DistinctBlockers(indexBits);
 
     totalEntries += tableEntries;
@@ -146,12 +186,12 @@ static void FillHashTable(
     assert(totalEntries <= NUM_HASH_ENTRIES);
 
     TempStorage_t* tempStorageTable = malloc(tableEntries * sizeof(*tempStorageTable));
-    InitTempStorage(tempStorageTable, mask, indexBits, square, callback);
+    InitTempStorage(tempStorageTable, entry->mask, indexBits, square, callback);
 
     for(int i = 0; i < tableEntries; i++) {
         Bitboard_t blockers = tempStorageTable[i].blockers;
         Bitboard_t attacks = tempStorageTable[i].attacks;
-        Hash_t hash = MagicHash(blockers, magic, shift);
+        Hash_t hash = TableIndex(indexing, blockers, entry);
 
         if(hashTable[hash + offset] == uninitialized) {
            hashTable[hash + offset] = attacks;
@@ -167,6 +207,7 @@ static void InitMagicEntries(
     MagicEntry_t magicEntries[NUM_SQUARES],
     MagicBB_t magicTable[NUM_SQUARES],
     Bitboard_t hashTable[NUM_HASH_ENTRIES],
+    Indexing_t indexing,
     FindMaskCallback_t FindMaskCallback, 
     BlockersToAttacksCallback_t BlockersToAttacksCallback
 ) 
@@ -179,45 +220,128 @@ static void InitMagicEntries(
         magicEntries[square].offset = totalEntries;
 
         FillHashTable(
-            magicEntries[square].magic,
+            &magicEntries[square],
             hashTable,
-            magicEntries[square].offset,
-            magicEntries[square].shift,
-            magicEntries[square].mask,
+            indexing,
             square,
             BlockersToAttacksCallback
         );
     }
 }
 
-static void InitRookEntries(MagicEntry_t magicEntries[NUM_SQUARES], Bitboard_t hashTable[NUM_HASH_ENTRIES]) {
+static void InitRookEntries(MagicEntry_t magicEntries[NUM_SQUARES], Bitboard_t hashTable[NUM_HASH_ENTRIES], Indexing_t indexing) {
     MagicBB_t magicTable[NUM_SQUARES] = ROOK_MAGICS;
-    InitMagicEntries(magicEntries, magicTable, hashTable, FindRookMask, FindRookAttacksFromBlockers);
+    InitMagicEntries(magicEntries, magicTable, hashTable, indexing, FindRookMask, FindRookAttacksFromBlockers);
 }
 
-static void InitBishopEntries(MagicEntry_t magicEntries[NUM_SQUARES], Bitboard_t hashTable[NUM_HASH_ENTRIES]) {
+static void InitBishopEntries(MagicEntry_t magicEntries[NUM_SQUARES], Bitboard_t hashTable[NUM_HASH_ENTRIES], Indexing_t indexing) {
     MagicBB_t magicTable[NUM_SQUARES] = BISHOP_MAGICS;
-    InitMagicEntries(magicEntries, magicTable, hashTable, FindBishopMask, FindBishopAttacksFromBlockers);
+    InitMagicEntries(magicEntries, magicTable, hashTable, indexing, FindBishopMask, FindBishopAttacksFromBlockers);
 }
 
-void InitAllMagicEntries(
+// Both indexings give every square a slice of exactly 2^(mask bits) entries, so the offsets and the table size are the same.
+static void InitAllEntries(
     MagicEntry_t rookMagicEntries[NUM_SQUARES],
     MagicEntry_t bishopMagicEntries[NUM_SQUARES],
-    Bitboard_t hashTable[NUM_HASH_ENTRIES]
+    Bitboard_t hashTable[NUM_HASH_ENTRIES],
+    Indexing_t indexing
 )
 {
     totalEntries = 0;
     InitHashTable(hashTable, NUM_HASH_ENTRIES);
-    InitRookEntries(rookMagicEntries, hashTable);
-    InitBishopEntries(bishopMagicEntries, hashTable);
+    InitRookEntries(rookMagicEntries, hashTable, indexing);
+    InitBishopEntries(bishopMagicEntries, hashTable, indexing);
 
     assert(totalEntries == NUM_HASH_ENTRIES);
 }
 
+void InitAllMagicEntries(
+    MagicEntry_t rookMagicEntries[NUM_SQUARES],
+    MagicEntry_t bishopMagicEntries[NUM_SQUARES],
+    Bitboard_t hashTable[NUM_HASH_ENTRIES]
+)
+{
+    InitAllEntries(rookMagicEntries, bishopMagicEntries, hashTable, magic_indexing);
+}
+
+void InitAllPextEntries(
+    MagicEntry_t rookMagicEntries[NUM_SQUARES],
+    MagicEntry_t bishopMagicEntries[NUM_SQUARES],
+    Bitboard_t hashTable[NUM_HASH_ENTRIES]
+)
+{
+    InitAllEntries(rookMagicEntries, bishopMagicEntries, hashTable, pext_indexing);
+}
+
+#ifdef PEXT_BACKEND
+// Zen 1 and 2 report BMI2 but PEXT takes hundreds of cycles there, so they're better off with magics
+static bool PextIsMicrocoded() {
+    unsigned int eax, ebx, ecx, edx;
+    if(!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) {
+        return true;
+    }
+
+    // the vendor string is split across ebx, edx, ecx, "Auth" is enough to tell AMD apart
+    bool isAmd = ebx == 0x68747541;
+    if(!isAmd) {
+        return false;
+    }
+
+    __get_cpuid(cpuid_features_leaf, &eax, &ebx, &ecx, &edx);
+    unsigned int family = (eax >> 8) & 0xf;
+    if(family == 0xf) {
+        family += (eax >> 20) & 0xff;
+    }
+
+    return family < amd_fast_pext_family;
+}
+
+bool CpuSupportsPext() {
+    unsigned int eax, ebx, ecx, edx;
+    if(!__get_cpuid_count(cpuid_extended_features_leaf, 0, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+
+    return ebx & cpuid_bmi2_bit;
+}
+
+bool CpuHasFastPext() {
+    return CpuSupportsPext() && !PextIsMicrocoded();
+}
+
+__attribute__((target("bmi2")))
+Bitboard_t FindSlidingAttackSetWithPext(
+    MagicEntry_t magicEntry,
+    Bitboard_t blockers,
+    const Bitboard_t hashTable[NUM_HASH_ENTRIES]
+)
+{
+    return hashTable[_pext_u64(blockers, magicEntry.mask) + magicEntry.offset];
+}
+#else
+bool CpuSupportsPext() {
+    return false;
+}
+
+bool CpuHasFastPext() {
+    return false;
+}
+
+// never picked without the instruction, but keeps the table usable if someone fills it with PEXT indexing anyway
+Bitboard_t FindSlidingAttackSetWithPext(
+    MagicEntry_t magicEntry,
+    Bitboard_t blockers,
+    const Bitboard_t hashTable[NUM_HASH_ENTRIES]
+)
+{
+    return hashTable[SoftwarePext(blockers, magicEntry.mask) + magicEntry.offset];
+}
+#endif
+
 Bitboard_t FindSlidingAttackSetInHashTable(
     MagicEntry_t magicEntry,
     Bitboard_t blockers,
-    Bitboard_t hashTable[NUM_HASH_ENTRIES]
+    const Bitboard_t hashTable[NUM_HASH_ENTRIES]
 )
 {
     Hash_t hash = MagicHash(blockers, magicEntry.magic, magicEntry.shift);
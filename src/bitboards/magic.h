@@ -2,6 +2,7 @@
 #define __MAGIC_H__
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "board_constants.h"
 
@@ -25,7 +26,25 @@ void InitAllMagicEntries(
 Bitboard_t FindSlidingAttackSetInHashTable(
     MagicEntry_t magicEntry,
     Bitboard_t blockers,
+    const Bitboard_t hashTable[NUM_HASH_ENTRIES]
+);
+
+// Same masks and offsets as the magic entries, but every slice is indexed by PEXT of the blockers instead
+void InitAllPextEntries(
+    MagicEntry_t rookMagicEntries[NUM_SQUARES],
+    MagicEntry_t bishopMagicEntries[NUM_SQUARES],
     Bitboard_t hashTable[NUM_HASH_ENTRIES]
 );
 
+Bitboard_t FindSlidingAttackSetWithPext(
+    MagicEntry_t magicEntry,
+    Bitboard_t blockers,
+    const Bitboard_t hashTable[NUM_HASH_ENTRIES]
+);
+
+bool CpuSupportsPext();
+
+// BMI2 and PEXT isn't emulated in microcode
+bool CpuHasFastPext();
+
 #endif
\ No newline at end of file
@@ -76,18 +76,18 @@ GameEndStatus_t CurrentGameEndStatus(
         }
     }
 
-    HalfmoveCount_t halfmoves = ReadHalfmoveClock(gameStack);
-    if(IsThreefoldRepetition(zobristStack, halfmoves)) {
+    if(PositionIsDrawn(boardInfo, gameStack, zobristStack)) {
         return draw;
     }
 
-    if(IsInsufficientMaterialDraw(boardInfo)) {
-        return draw;
-    }
+    return ongoing;
+}
 
-    if(halfmoves >= 100) {
-        return draw;
-    }
+bool PositionIsDrawn(BoardInfo_t* boardInfo, GameStack_t* gameStack, ZobristStack_t* zobristStack) {
+    HalfmoveCount_t halfmoves = ReadHalfmoveClock(gameStack);
 
-    return ongoing;
+    return
+        IsThreefoldRepetition(zobristStack, halfmoves) ||
+        IsInsufficientMaterialDraw(boardInfo) ||
+        halfmoves >= 100;
 }
\ No newline at end of file
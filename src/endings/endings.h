@@ -25,4 +25,7 @@ GameEndStatus_t CurrentGameEndStatus(
     int moveListMaxIndex
 );
 
+// repetition, insufficient material and the fifty move rule, everything that doesn't need the legal moves
+bool PositionIsDrawn(BoardInfo_t* boardInfo, GameStack_t* gameStack, ZobristStack_t* zobristStack);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,312 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+#include "NNUE.h"
+#include "evaluation.h"
+#include "PST.h"
+#include "util_macros.h"
+
+enum {
+    activation_max = 255, // QA, the accumulator is clipped to [0, QA] before the output layer
+    output_quantization = 64, // QB
+    output_scale = 400, // turns the network's output into centipawns
+
+    features_per_side = nnue_inputs / 2,
+
+    // the embedded network has one neuron per (side, piece, rank), each holding value/8 of the pieces on it
+    embedded_weight_divisor = 8,
+    embedded_neurons_per_side = 48,
+    embedded_king_bias = 16, // so a king on a negative PST square doesn't get clipped
+    embedded_output_weight = (embedded_weight_divisor * activation_max * output_quantization) / output_scale
+};
+
+typedef struct {
+    alignas(32) NNUEValue_t featureWeights[nnue_inputs][nnue_hidden];
+    alignas(32) NNUEValue_t featureBiases[nnue_hidden];
+    alignas(32) NNUEValue_t outputWeights[2][nnue_hidden]; // side to move's half first
+    NNUEValue_t outputBias;
+} Network_t;
+
+static Network_t network;
+static Network_t embeddedNetwork;
+
+// trainers order pieces P N B R Q K, my enum starts with the knight
+static const int featurePieceIndex[6] = { 1, 2, 3, 4, 0, 5 };
+
+static Centipawns_t midgamePST[6][NUM_SQUARES] = { KNIGHT_MG_PST, BISHOP_MG_PST, ROOK_MG_PST, QUEEN_MG_PST, PAWN_MG_PST, KING_MG_PST };
+
+static int FeatureIndex(Color_t perspective, Piece_t piece, Color_t color, Square_t square) {
+    Square_t relativeSquare = (perspective == white) ? square : MIRROR(square);
+    int side = (color == perspective) ? 0 : 1;
+    return side * features_per_side + featurePieceIndex[piece] * NUM_SQUARES + relativeSquare;
+}
+
+#if defined(__AVX2__)
+
+typedef __m256i Vector_t;
+enum { vector_lanes = 16 };
+
+static inline Vector_t LoadVector(const NNUEValue_t* values) { return _mm256_loadu_si256((const Vector_t*)values); }
+static inline void StoreVector(NNUEValue_t* values, Vector_t v) { _mm256_storeu_si256((Vector_t*)values, v); }
+static inline Vector_t AddVectors(Vector_t a, Vector_t b) { return _mm256_add_epi16(a, b); }
+static inline Vector_t SubtractVectors(Vector_t a, Vector_t b) { return _mm256_sub_epi16(a, b); }
+
+// clipped ReLU times the output weights, summed pairwise into 32 bit lanes
+static inline Vector_t ActivateAndMultiply(Vector_t values, Vector_t weights) {
+    Vector_t clipped = _mm256_min_epi16(_mm256_max_epi16(values, _mm256_setzero_si256()), _mm256_set1_epi16(activation_max));
+    return _mm256_madd_epi16(clipped, weights);
+}
+
+static inline Vector_t AddSums(Vector_t a, Vector_t b) { return _mm256_add_epi32(a, b); }
+static inline Vector_t ZeroSum() { return _mm256_setzero_si256(); }
+
+static inline int32_t HorizontalSum(Vector_t sum) {
+    __m128i halves = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    halves = _mm_add_epi32(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(1, 0, 3, 2)));
+    halves = _mm_add_epi32(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(halves);
+}
+
+#elif defined(__SSE4_1__)
+
+typedef __m128i Vector_t;
+enum { vector_lanes = 8 };
+
+static inline Vector_t LoadVector(const NNUEValue_t* values) { return _mm_loadu_si128((const Vector_t*)values); }
+static inline void StoreVector(NNUEValue_t* values, Vector_t v) { _mm_storeu_si128((Vector_t*)values, v); }
+static inline Vector_t AddVectors(Vector_t a, Vector_t b) { return _mm_add_epi16(a, b); }
+static inline Vector_t SubtractVectors(Vector_t a, Vector_t b) { return _mm_sub_epi16(a, b); }
+
+static inline Vector_t ActivateAndMultiply(Vector_t values, Vector_t weights) {
+    Vector_t clipped = _mm_min_epi16(_mm_max_epi16(values, _mm_setzero_si128()), _mm_set1_epi16(activation_max));
+    return _mm_madd_epi16(clipped, weights);
+}
+
+static inline Vector_t AddSums(Vector_t a, Vector_t b) { return _mm_add_epi32(a, b); }
+static inline Vector_t ZeroSum() { return _mm_setzero_si128(); }
+
+static inline int32_t HorizontalSum(Vector_t sum) {
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+
+#endif
+
+// out = in + the columns of every added feature - the columns of every removed one.
+// All the changes are applied per register, so each accumulator is only loaded and stored once
+static void UpdateValues(
+    NNUEValue_t* out,
+    const NNUEValue_t* in,
+    const int* added,
+    int numAdded,
+    const int* removed,
+    int numRemoved
+)
+{
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    for(int i = 0; i < nnue_hidden; i += vector_lanes) {
+        Vector_t values = LoadVector(&in[i]);
+        for(int j = 0; j < numAdded; j++) {
+            values = AddVectors(values, LoadVector(&network.featureWeights[added[j]][i]));
+        }
+        for(int j = 0; j < numRemoved; j++) {
+            values = SubtractVectors(values, LoadVector(&network.featureWeights[removed[j]][i]));
+        }
+        StoreVector(&out[i], values);
+    }
+#else
+    for(int i = 0; i < nnue_hidden; i++) {
+        NNUEValue_t value = in[i];
+        for(int j = 0; j < numAdded; j++) {
+            value += network.featureWeights[added[j]][i];
+        }
+        for(int j = 0; j < numRemoved; j++) {
+            value -= network.featureWeights[removed[j]][i];
+        }
+        out[i] = value;
+    }
+#endif
+}
+
+static int32_t OutputLayer(const NNUEValue_t* us, const NNUEValue_t* them) {
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    Vector_t sum = ZeroSum();
+    for(int i = 0; i < nnue_hidden; i += vector_lanes) {
+        sum = AddSums(sum, ActivateAndMultiply(LoadVector(&us[i]), LoadVector(&network.outputWeights[0][i])));
+        sum = AddSums(sum, ActivateAndMultiply(LoadVector(&them[i]), LoadVector(&network.outputWeights[1][i])));
+    }
+    int32_t output = HorizontalSum(sum);
+#else
+    int32_t output = 0;
+    for(int i = 0; i < nnue_hidden; i++) {
+        int32_t clippedUs = us[i];
+        int32_t clippedThem = them[i];
+        CLAMP_TO_RANGE(clippedUs, 0, activation_max);
+        CLAMP_TO_RANGE(clippedThem, 0, activation_max);
+        output += clippedUs * network.outputWeights[0][i] + clippedThem * network.outputWeights[1][i];
+    }
+#endif
+
+    output += network.outputBias;
+    return output * output_scale / (activation_max * output_quantization);
+}
+
+static void RefreshAccumulator(Accumulator_t* accumulator, BoardInfo_t* boardInfo, ZobristHash_t hash) {
+    for(int perspective = white; perspective <= black; perspective++) {
+        int features[32];
+        int numFeatures = 0;
+
+        for(int color = white; color <= black; color++) {
+            for(Piece_t piece = knight; piece <= king; piece++) {
+                Bitboard_t pieces = *GetPieceInfoField(boardInfo, piece, color);
+                while(pieces) {
+                    assert(numFeatures < 32);
+                    features[numFeatures++] = FeatureIndex(perspective, piece, color, LSB(pieces));
+                    ResetLSB(&pieces);
+                }
+            }
+        }
+
+        UpdateValues(accumulator->values[perspective], network.featureBiases, features, numFeatures, NULL, 0);
+    }
+
+    accumulator->hash = hash;
+}
+
+static void ApplyDirtyPieces(Accumulator_t* next, const Accumulator_t* previous, GameState_t* state) {
+    for(int perspective = white; perspective <= black; perspective++) {
+        int added[max_dirty_pieces];
+        int removed[max_dirty_pieces];
+        int numAdded = 0;
+        int numRemoved = 0;
+
+        for(int i = 0; i < state->numDirtyPieces; i++) {
+            DirtyPiece_t* dirty = &state->dirtyPieces[i];
+            if(dirty->fromSquare != no_square) {
+                removed[numRemoved++] = FeatureIndex(perspective, dirty->piece, dirty->color, dirty->fromSquare);
+            }
+            if(dirty->toSquare != no_square) {
+                added[numAdded++] = FeatureIndex(perspective, dirty->piece, dirty->color, dirty->toSquare);
+            }
+        }
+
+        UpdateValues(next->values[perspective], previous->values[perspective], added, numAdded, removed, numRemoved);
+    }
+
+    next->hash = state->hash;
+}
+
+// Nothing happens on make or unmake. Instead, evaluation walks down to the closest accumulator that's
+// still up to date and replays the dirty pieces from there, so positions that are never evaluated cost nothing
+static Accumulator_t* UpToDateAccumulator(BoardInfo_t* boardInfo, GameStack_t* gameStack, AccumulatorStack_t* accumulatorStack) {
+    Accumulator_t* accumulators = accumulatorStack->accumulators;
+    GameState_t* gameStates = gameStack->gameStates;
+    int top = gameStack->top;
+
+    int computed = top;
+    while(computed >= 0 && accumulators[computed].hash != gameStates[computed].hash) {
+        computed--;
+    }
+
+    if(computed < 0) {
+        RefreshAccumulator(&accumulators[top], boardInfo, gameStates[top].hash);
+        return &accumulators[top];
+    }
+
+    for(int i = computed + 1; i <= top; i++) {
+        ApplyDirtyPieces(&accumulators[i], &accumulators[i - 1], &gameStates[i]);
+    }
+
+    return &accumulators[top];
+}
+
+static NNUEValue_t EmbeddedWeight(Centipawns_t value) {
+    return (value + embedded_weight_divisor / 2) / embedded_weight_divisor;
+}
+
+// There's no trained network in the repo, so the default one is the midgame material + PST eval written as a net:
+// every (side, piece, rank) gets a neuron adding up its pieces' values, and the output layer adds ours and subtracts theirs.
+// It's there so the backend works out of the box, load a real one with EvalFile
+static void BuildEmbeddedNetwork(Network_t* net) {
+    memset(net, 0, sizeof(*net));
+
+    for(int side = 0; side < 2; side++) {
+        for(Piece_t piece = knight; piece <= king; piece++) {
+            for(Square_t square = 0; square < NUM_SQUARES; square++) {
+                // the PST is written for black, so our pieces read it mirrored like white does
+                Square_t pstSquare = (side == 0) ? MIRROR(square) : square;
+                Centipawns_t value = ValueOfPiece(piece) + midgamePST[piece][pstSquare];
+
+                int feature = side * features_per_side + featurePieceIndex[piece] * NUM_SQUARES + square;
+                int neuron = side * embedded_neurons_per_side + featurePieceIndex[piece] * 8 + square / 8;
+                net->featureWeights[feature][neuron] = EmbeddedWeight(value);
+            }
+        }
+
+        for(int rank = 0; rank < 8; rank++) {
+            net->featureBiases[side * embedded_neurons_per_side + featurePieceIndex[king] * 8 + rank] = embedded_king_bias;
+        }
+
+        for(int neuron = 0; neuron < embedded_neurons_per_side; neuron++) {
+            net->outputWeights[0][side * embedded_neurons_per_side + neuron] = (side == 0) ? embedded_output_weight : -embedded_output_weight;
+        }
+    }
+}
+
+void NNUEInit() {
+    BuildEmbeddedNetwork(&embeddedNetwork);
+    NNUEUseEmbeddedNetwork();
+}
+
+void NNUEUseEmbeddedNetwork() {
+    network = embeddedNetwork;
+}
+
+static bool ReadValues(FILE* file, NNUEValue_t* values, size_t count) {
+    return fread(values, sizeof(NNUEValue_t), count, file) == count;
+}
+
+bool NNUELoadNetwork(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if(file == NULL) {
+        return false;
+    }
+
+    static Network_t loaded;
+    bool success =
+        ReadValues(file, &loaded.featureWeights[0][0], nnue_inputs * nnue_hidden) &&
+        ReadValues(file, loaded.featureBiases, nnue_hidden) &&
+        ReadValues(file, &loaded.outputWeights[0][0], 2 * nnue_hidden) &&
+        ReadValues(file, &loaded.outputBias, 1);
+
+    // trainers pad the file to a multiple of 64 bytes, anything longer is a different architecture
+    int padding = 0;
+    while(success && fgetc(file) != EOF) {
+        padding++;
+    }
+    fclose(file);
+
+    if(!success || padding >= 64) {
+        return false;
+    }
+
+    network = loaded;
+    return true;
+}
+
+void ClearAccumulatorStack(AccumulatorStack_t* accumulatorStack) {
+    memset(accumulatorStack, 0, sizeof(*accumulatorStack));
+}
+
+int32_t NNUEEvaluate(BoardInfo_t* boardInfo, GameStack_t* gameStack, AccumulatorStack_t* accumulatorStack) {
+    Accumulator_t* accumulator = UpToDateAccumulator(boardInfo, gameStack, accumulatorStack);
+
+    Color_t us = boardInfo->colorToMove;
+    return OutputLayer(accumulator->values[us], accumulator->values[!us]);
+}
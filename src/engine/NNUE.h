@@ -0,0 +1,46 @@
+#ifndef __NNUE_H__
+#define __NNUE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdalign.h>
+
+#include "board_constants.h"
+#include "board_info.h"
+#include "game_state.h"
+
+// (768 -> 256)x2 -> 1, clipped ReLU. The inputs are every (color, piece, square) seen from one side,
+// and the layout matches the plain perspective nets most trainers export.
+enum {
+    nnue_inputs = 768,
+    nnue_hidden = 256
+};
+
+typedef int16_t NNUEValue_t;
+
+// the first layer's output for both perspectives. It's tagged with the hash of the position it was computed for,
+// so an entry is up to date exactly when its hash matches the game state at the same height
+typedef struct {
+    alignas(32) NNUEValue_t values[2][nnue_hidden];
+    ZobristHash_t hash;
+} Accumulator_t;
+
+// parallel to the game stack, every search thread owns one
+typedef struct {
+    Accumulator_t accumulators[GAMESTATES_MAX];
+} AccumulatorStack_t;
+
+// builds the embedded network, call once at startup
+void NNUEInit();
+
+// loads a network in the trainer's raw format, keeping the current one if the file doesn't fit
+bool NNUELoadNetwork(const char* path);
+
+void NNUEUseEmbeddedNetwork();
+
+void ClearAccumulatorStack(AccumulatorStack_t* accumulatorStack);
+
+// from the side to move's point of view, in centipawns
+int32_t NNUEEvaluate(BoardInfo_t* boardInfo, GameStack_t* gameStack, AccumulatorStack_t* accumulatorStack);
+
+#endif
@@ -7,7 +7,6 @@
 // also inspired by PeSTO's eval 
 // all values are from black's perspective, becuase my scheme is flipped
 
-typedef uint8_t Phase_t;
 enum {
     mg_phase,
     eg_phase,
@@ -0,0 +1,204 @@
+#include "SEE.h"
+#include "lookup.h"
+#include "bitboards.h"
+#include "util_macros.h"
+
+enum {
+    swap_list_max = 32
+};
+
+// cheapest first, the order attackers are used in
+static Piece_t attackerOrder[] = { pawn, knight, bishop, rook, queen, king };
+
+static Bitboard_t AttackersTo(BoardInfo_t* boardInfo, Square_t square, Bitboard_t occupied) {
+    Bitboard_t squareBB = GetSingleBitset(square);
+    Bitboard_t empty = ~occupied;
+
+    Bitboard_t whitePawnAttackers = (SoWeOne(squareBB) | SoEaOne(squareBB)) & boardInfo->pawns[white];
+    Bitboard_t blackPawnAttackers = (NoWeOne(squareBB) | NoEaOne(squareBB)) & boardInfo->pawns[black];
+
+    return
+        whitePawnAttackers |
+        blackPawnAttackers |
+        (GetKnightAttackSet(square) & (boardInfo->knights[white] | boardInfo->knights[black])) |
+        (GetKingAttackSet(square) & (boardInfo->kings[white] | boardInfo->kings[black])) |
+        (GetBishopAttackSet(square, empty) & (AllD12Sliders(boardInfo, white) | AllD12Sliders(boardInfo, black))) |
+        (GetRookAttackSet(square, empty) & (AllHvSliders(boardInfo, white) | AllHvSliders(boardInfo, black)));
+}
+
+// once a piece has captured, the sliders lined up behind it can join in
+static Bitboard_t RevealXRays(BoardInfo_t* boardInfo, Square_t square, Bitboard_t occupied, Piece_t capturer) {
+    Bitboard_t empty = ~occupied;
+    Bitboard_t revealed = empty_set;
+
+    if(capturer == pawn || capturer == bishop || capturer == queen) {
+        revealed |= GetBishopAttackSet(square, empty) & (AllD12Sliders(boardInfo, white) | AllD12Sliders(boardInfo, black));
+    }
+
+    if(capturer == rook || capturer == queen) {
+        revealed |= GetRookAttackSet(square, empty) & (AllHvSliders(boardInfo, white) | AllHvSliders(boardInfo, black));
+    }
+
+    return revealed & occupied;
+}
+
+static Bitboard_t LeastValuableAttacker(BoardInfo_t* boardInfo, Bitboard_t attackers, Color_t color, Piece_t* piece) {
+    for(int i = 0; i < NUM_ARRAY_ELEMENTS(attackerOrder); i++) {
+        Bitboard_t pieceAttackers = attackers & *GetPieceInfoField(boardInfo, attackerOrder[i], color);
+        if(pieceAttackers) {
+            *piece = attackerOrder[i];
+            return GetSingleBitset(LSB(pieceAttackers));
+        }
+    }
+
+    *piece = none_type;
+    return empty_set;
+}
+
+static Piece_t CapturedPiece(BoardInfo_t* boardInfo, Move_t move) {
+    if(ReadSpecialFlag(move) == en_passant_flag) {
+        return pawn;
+    }
+
+    return PieceOnSquare(boardInfo, ReadToSquare(move));
+}
+
+// ValueOfPiece treats an empty square as a pawn, but a quiet move wins nothing
+static EvalScore_t CapturedValue(BoardInfo_t* boardInfo, Move_t move) {
+    Piece_t captured = CapturedPiece(boardInfo, move);
+    return (captured == none_type) ? 0 : ValueOfPiece(captured);
+}
+
+// a promotion wins the difference between the new piece and the pawn, and it's the new piece that can be taken back
+static EvalScore_t PromotionGain(Move_t move) {
+    if(ReadSpecialFlag(move) != promotion_flag) {
+        return 0;
+    }
+
+    return ValueOfPiece(ReadPromotionPiece(move)) - ValueOfPiece(pawn);
+}
+
+static Piece_t PieceAfterMove(BoardInfo_t* boardInfo, Move_t move) {
+    if(ReadSpecialFlag(move) == promotion_flag) {
+        return ReadPromotionPiece(move);
+    }
+
+    return PieceOnSquare(boardInfo, ReadFromSquare(move));
+}
+
+// the board with the move already made, as far as attacks through the target square are concerned
+static Bitboard_t OccupiedAfterMove(BoardInfo_t* boardInfo, Move_t move, Color_t color) {
+    Square_t toSquare = ReadToSquare(move);
+    Bitboard_t occupied = ~boardInfo->empty ^ GetSingleBitset(ReadFromSquare(move));
+
+    if(ReadSpecialFlag(move) == en_passant_flag) {
+        Bitboard_t toBB = GetSingleBitset(toSquare);
+        occupied ^= (color == white) ? SoutOne(toBB) : NortOne(toBB);
+    }
+
+    return occupied | GetSingleBitset(toSquare);
+}
+
+EvalScore_t SEEValue(BoardInfo_t* boardInfo, Move_t move) {
+    if(ReadSpecialFlag(move) == castle_flag) {
+        return 0;
+    }
+
+    Square_t toSquare = ReadToSquare(move);
+    Color_t side = boardInfo->colorToMove;
+    Piece_t mover = PieceAfterMove(boardInfo, move);
+
+    EvalScore_t gain[swap_list_max];
+    gain[0] = CapturedValue(boardInfo, move) + PromotionGain(move);
+
+    Bitboard_t occupied = OccupiedAfterMove(boardInfo, move, side);
+    Bitboard_t attackers = AttackersTo(boardInfo, toSquare, occupied) & occupied;
+    EvalScore_t onSquareValue = ValueOfPiece(mover);
+
+    int depth = 0;
+    while(depth < swap_list_max - 1) {
+        side = !side;
+        Bitboard_t sideAttackers = attackers & boardInfo->allPieces[side];
+
+        Piece_t capturer;
+        Bitboard_t capturerBB = LeastValuableAttacker(boardInfo, sideAttackers, side, &capturer);
+        if(capturerBB == empty_set) {
+            break;
+        }
+
+        // the king can only take if nothing is left to take it back
+        if(capturer == king && (attackers & boardInfo->allPieces[!side])) {
+            break;
+        }
+
+        depth++;
+        gain[depth] = onSquareValue - gain[depth-1];
+        onSquareValue = ValueOfPiece(capturer);
+
+        occupied ^= capturerBB;
+        attackers = (attackers & occupied) | RevealXRays(boardInfo, toSquare, occupied, capturer);
+    }
+
+    // each side only keeps capturing if it is better for them than stopping
+    while(depth > 0) {
+        EvalScore_t stopHere = -gain[depth-1];
+        gain[depth-1] = (stopHere > gain[depth]) ? -stopHere : -gain[depth];
+        depth--;
+    }
+
+    return gain[0];
+}
+
+bool SEEPassesThreshold(BoardInfo_t* boardInfo, Move_t move, EvalScore_t threshold) {
+    if(ReadSpecialFlag(move) == castle_flag) {
+        return 0 >= threshold;
+    }
+
+    Square_t toSquare = ReadToSquare(move);
+    Color_t side = boardInfo->colorToMove;
+    Piece_t mover = PieceAfterMove(boardInfo, move);
+
+    // even winning the victim for free isn't enough
+    EvalScore_t swap = CapturedValue(boardInfo, move) + PromotionGain(move) - threshold;
+    if(swap < 0) {
+        return false;
+    }
+
+    // even losing the mover for nothing is still enough
+    swap = ValueOfPiece(mover) - swap;
+    if(swap <= 0 || mover == king) {
+        return true;
+    }
+
+    Bitboard_t occupied = OccupiedAfterMove(boardInfo, move, side);
+    Bitboard_t attackers = AttackersTo(boardInfo, toSquare, occupied) & occupied;
+
+    // passes is flipped every capture, it is whether the threshold is met if the side that just captured is the last one to
+    bool passes = true;
+    while(true) {
+        side = !side;
+        Bitboard_t sideAttackers = attackers & boardInfo->allPieces[side];
+
+        Piece_t capturer;
+        Bitboard_t capturerBB = LeastValuableAttacker(boardInfo, sideAttackers, side, &capturer);
+        if(capturerBB == empty_set) {
+            break;
+        }
+
+        if(capturer == king) {
+            // the king recapturing only stands if the other side has nothing left
+            return (attackers & boardInfo->allPieces[!side]) ? passes : !passes;
+        }
+
+        passes = !passes;
+        swap = ValueOfPiece(capturer) - swap;
+        if(swap < passes) {
+            break;
+        }
+
+        occupied ^= capturerBB;
+        attackers = (attackers & occupied) | RevealXRays(boardInfo, toSquare, occupied, capturer);
+    }
+
+    return passes;
+}
@@ -0,0 +1,19 @@
+#ifndef __SEE_H__
+#define __SEE_H__
+
+#include <stdbool.h>
+
+#include "board_info.h"
+#include "move.h"
+#include "evaluation.h"
+
+// Static exchange evaluation: the material balance after both sides trade off
+// every attacker of the target square, cheapest first, stopping whenever continuing would lose material.
+// Pins are ignored, x-rays through the pieces that have already captured are not.
+
+EvalScore_t SEEValue(BoardInfo_t* boardInfo, Move_t move);
+
+// same as SEEValue(move) >= threshold, but bails out as soon as the answer is known
+bool SEEPassesThreshold(BoardInfo_t* boardInfo, Move_t move, EvalScore_t threshold);
+
+#endif
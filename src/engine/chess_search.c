@@ -1,5 +1,12 @@
+#include <assert.h>
+#include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <stdalign.h>
 #include <time.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <math.h>
 
 #include "chess_search.h"
 #include "movegen.h"
@@ -11,11 +18,51 @@
 #include "timer.h"
 #include "PV_table.h"
 #include "move_ordering.h"
+#include "move_picker.h"
+#include "SEE.h"
+#include "transposition_table.h"
+#include "legals.h"
 
 enum {
-    time_fraction = 25,
     timer_check_freq = 1024,
 
+    default_moves_to_go = 25,
+    max_moves_to_go = 50,
+    increment_usage_percent = 75,
+    hard_limit_multiplier = 4,
+    hard_limit_max_percent = 75, // of what's left on the clock, so one move can never flag us
+
+    stable_iterations_max = 4,
+    score_drop_max = 100,
+    score_drop_scale = 5, // per mille of extra soft time for every centipawn the score dropped
+
+    aspiration_min_depth = 5,
+    aspiration_initial_delta = 25,
+    aspiration_max_delta = 1000,
+
+    null_move_min_depth = 3,
+    null_move_base_reduction = 3,
+    null_move_depth_divisor = 4,
+    null_move_eval_divisor = 200,
+    null_move_max_eval_reduction = 3,
+    null_move_verification_depth = 12,
+
+    lmr_min_depth = 3,
+    lmr_first_reduced_move = 2,
+    lmr_history_divisor = 16384,
+
+    lmp_max_depth = 3,
+    lmp_base_move_count = 3,
+
+    singular_min_depth = 8,
+    singular_tt_depth_margin = 3,
+    singular_margin_per_depth = 2,
+
+    extension_ply_multiplier = 2, // extended lines may reach at most this many times the root depth
+
+    history_bonus_scale = 32,
+    history_max_bonus = 1536,
+
     MATE_THRESHOLD = EVAL_MAX - 100,
 
     DEPTH_MAX = PLY_MAX
@@ -25,26 +72,163 @@ enum {
 #define MATED "mate -"
 #define NO_MATE "cp "
 
+#define NO_BOUND ""
+#define LOWERBOUND " lowerbound"
+#define UPPERBOUND " upperbound"
+
 typedef struct {
     bool outOfTime;
-    NodeCount_t nodeCount;
+    bool isMainThread;
+    bool hasResult; // only the main thread uses it, the limits can't stop it before its first iteration is done
+    NodeCount_t nodeLimit;
+    atomic_bool* stopSignal;
+    atomic_bool* pondering;
+    _Atomic NodeCount_t nodeCount; // the main thread adds up every thread's count while they're searching
     PvTable_t pvTable;
+    MoveOrderingInfo_t orderingInfo;
+    SearchStackEntry_t searchStack[PLY_MAX];
+    EvaluationInfo_t evalInfo;
+    Depth_t rootDepth;
+
+    // the TT move each ply is testing for singularity, the verification search skips it
+    Move_t excludedMoves[PLY_MAX];
+
+    // root moves that already have a MultiPV line this iteration, the root search skips them
+    Move_t excludedRootMoves[multipv_max];
+    int numExcludedRootMoves;
 } ChessSearchInfo_t;
 
-static Timer_t globalTimer;
+// one MultiPV line, copied out of the PV table once its search finishes
+typedef struct {
+    EvalScore_t score;
+    PvLength_t pvLength;
+    Move_t pv[PLY_MAX];
+} RootLine_t;
+
+// every thread searches its own copy of the position, and they only talk to each other through the transposition table
+typedef struct {
+    int threadId;
+    pthread_t handle;
+
+    BoardInfo_t boardInfo;
+    GameStack_t gameStack;
+    ZobristStack_t zobristStack;
+    ChessSearchInfo_t searchInfo;
+} SearchThread_t;
+
+// The hard limit is checked inside the search and stops it wherever it is. The soft limit is only checked between
+// iterations, since starting an iteration we can't finish is wasted time. Only clock based searches have a soft limit.
+typedef struct {
+    Timer_t hardTimer;
+    Milliseconds_t softLimit;
+    bool isTimed; // false when there's no clock or movetime at all, so nothing about the search depends on wall time
+    bool isManaged;
+} TimeManager_t;
+
+static TimeManager_t timeManager;
+
+// per mille of the soft limit, by how many iterations in a row the best move has stayed the same
+static const int stabilityScale[stable_iterations_max + 1] = { 1800, 1300, 1050, 900, 800 };
+
+static const struct timespec gui_poll_interval = { 0, 1000000 }; // 1 ms
 
-static void InitSearchInfo(ChessSearchInfo_t* searchInfo) {
+// indexed by [depth][move number], filled once at startup by InitSearchTables
+static Depth_t lateMoveReductions[DEPTH_MAX + 1][MOVELIST_MAX];
+
+static SearchThread_t* threadPool = NULL;
+static int threadPoolSize = 0;
+
+// only the main thread searches more than one line
+static RootLine_t rootLines[multipv_max];
+
+static void InitSearchInfo(ChessSearchInfo_t* searchInfo, UciSearchInfo_t* uciSearchInfo, bool isMainThread) {
     searchInfo->outOfTime = false;
-    searchInfo->nodeCount = 0;
+    searchInfo->isMainThread = isMainThread;
+    searchInfo->hasResult = false;
+    searchInfo->nodeLimit = uciSearchInfo->nodeLimit;
+    searchInfo->stopSignal = &uciSearchInfo->stopSignal;
+    searchInfo->pondering = &uciSearchInfo->pondering;
+    atomic_store_explicit(&searchInfo->nodeCount, 0, memory_order_relaxed);
+    searchInfo->numExcludedRootMoves = 0;
+    searchInfo->rootDepth = 0;
+    for(int ply = 0; ply < PLY_MAX; ply++) {
+        InitMove(&searchInfo->excludedMoves[ply]);
+    }
+    InitMoveOrderingInfo(&searchInfo->orderingInfo);
+}
+
+static bool IsExcludedRootMove(ChessSearchInfo_t* searchInfo, Move_t move) {
+    for(int i = 0; i < searchInfo->numExcludedRootMoves; i++) {
+        if(SameMove(move, searchInfo->excludedRootMoves[i])) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 static bool ShouldCheckTimer(NodeCount_t nodeCount) {
     return nodeCount % timer_check_freq == 0;
 }
 
+static NodeCount_t ReadNodeCount(ChessSearchInfo_t* searchInfo) {
+    return atomic_load_explicit(&searchInfo->nodeCount, memory_order_relaxed);
+}
+
+// only the owning thread writes its count, so a relaxed load and store is enough and there's no locked add per node
+static void CountNode(ChessSearchInfo_t* searchInfo) {
+    atomic_store_explicit(&searchInfo->nodeCount, ReadNodeCount(searchInfo) + 1, memory_order_relaxed);
+}
+
+static NodeCount_t TotalNodeCount() {
+    NodeCount_t total = 0;
+    for(int i = 0; i < threadPoolSize; i++) {
+        total += ReadNodeCount(&threadPool[i].searchInfo);
+    }
+
+    return total;
+}
+
+// a single thread stops on the exact node, with helpers the total is only worth adding up now and then
+static bool NodeLimitReached(ChessSearchInfo_t* searchInfo) {
+    if(searchInfo->nodeLimit == 0) {
+        return false;
+    }
+
+    if(threadPoolSize == 1) {
+        return ReadNodeCount(searchInfo) >= searchInfo->nodeLimit;
+    }
+
+    return ShouldCheckTimer(ReadNodeCount(searchInfo)) && TotalNodeCount() >= searchInfo->nodeLimit;
+}
+
+static bool HardTimerExpired(ChessSearchInfo_t* searchInfo) {
+    return
+        timeManager.isTimed &&
+        ShouldCheckTimer(ReadNodeCount(searchInfo)) &&
+        !atomic_load_explicit(searchInfo->pondering, memory_order_relaxed) &&
+        TimerExpired(&timeManager.hardTimer);
+}
+
+// Every thread only polls the stop signal. The main thread owns the clock and the node limit,
+// so it is the only one that turns them into a stop. Nothing is timed while pondering,
+// but the timer started with the search, so after a ponderhit the time spent pondering counts.
+static bool SearchShouldStop(ChessSearchInfo_t* searchInfo) {
+    if(
+        searchInfo->isMainThread &&
+        searchInfo->hasResult &&
+        (NodeLimitReached(searchInfo) || HardTimerExpired(searchInfo))
+    )
+    {
+        atomic_store(searchInfo->stopSignal, true);
+    }
+
+    return atomic_load_explicit(searchInfo->stopSignal, memory_order_relaxed);
+}
+
 static void MakeAndAddHash(BoardInfo_t* boardInfo, GameStack_t* gameStack, Move_t move, ZobristStack_t* zobristStack) {
     MakeMove(boardInfo, gameStack, move);
-    AddZobristHashToStack(zobristStack, HashPosition(boardInfo, gameStack));
+    AddZobristHashToStack(zobristStack, ReadZobristHash(gameStack));
 }
 
 static void UnmakeAndRemoveHash(BoardInfo_t* boardInfo, GameStack_t* gameStack, ZobristStack_t* zobristStack) {
@@ -52,6 +236,187 @@ static void UnmakeAndRemoveHash(BoardInfo_t* boardInfo, GameStack_t* gameStack,
     RemoveZobristHashFromStack(zobristStack);
 }
 
+static void MakeNullAndAddHash(BoardInfo_t* boardInfo, GameStack_t* gameStack, ZobristStack_t* zobristStack) {
+    MakeNullMove(boardInfo, gameStack);
+    AddZobristHashToStack(zobristStack, ReadZobristHash(gameStack));
+}
+
+static void UnmakeNullAndRemoveHash(BoardInfo_t* boardInfo, GameStack_t* gameStack, ZobristStack_t* zobristStack) {
+    UnmakeNullMove(boardInfo, gameStack);
+    RemoveZobristHashFromStack(zobristStack);
+}
+
+static ZobristHash_t CurrentHash(ZobristStack_t* zobristStack) {
+    return zobristStack->entries[zobristStack->maxIndex];
+}
+
+// mate scores are stored relative to the node, so they stay correct when the position is reached at a different ply
+static EvalScore_t ScoreToTT(EvalScore_t score, Ply_t ply) {
+    if(score > MATE_THRESHOLD) {
+        return score + ply;
+    } else if(score < -MATE_THRESHOLD) {
+        return score - ply;
+    }
+
+    return score;
+}
+
+static EvalScore_t ScoreFromTT(EvalScore_t score, Ply_t ply) {
+    if(score > MATE_THRESHOLD) {
+        return score - ply;
+    } else if(score < -MATE_THRESHOLD) {
+        return score + ply;
+    }
+
+    return score;
+}
+
+static bool TTCutoffIsValid(TTEntry_t entry, EvalScore_t score, EvalScore_t alpha, EvalScore_t beta, Depth_t depth) {
+    if(entry.depth < depth) {
+        return false;
+    }
+
+    switch(entry.bound) {
+        case exact_bound:
+            return true;
+        case lower_bound:
+            return score >= beta;
+        case upper_bound:
+            return score <= alpha;
+    }
+
+    return false;
+}
+
+static bool SideToMoveInCheck(BoardInfo_t* boardInfo) {
+    Color_t color = boardInfo->colorToMove;
+    return InCheck(boardInfo->kings[color], UnsafeSquares(boardInfo, color));
+}
+
+// with only king and pawns left, zugzwang is common enough that passing the turn is no longer a safe lower bound
+static bool HasNonPawnMaterial(BoardInfo_t* boardInfo, Color_t color) {
+    return boardInfo->allPieces[color] & ~(boardInfo->pawns[color] | boardInfo->kings[color]);
+}
+
+static bool NullMoveIsAllowed(BoardInfo_t* boardInfo, bool isPvNode, bool inCheck, bool canNullMove, Depth_t depth) {
+    return
+        canNullMove &&
+        !isPvNode &&
+        !inCheck &&
+        depth >= null_move_min_depth &&
+        HasNonPawnMaterial(boardInfo, boardInfo->colorToMove);
+}
+
+// reduce more the deeper we are and the further the static eval is above beta
+static int NullMoveReduction(Depth_t depth, EvalScore_t staticEval, EvalScore_t beta) {
+    int evalReduction = (staticEval - beta) / null_move_eval_divisor;
+    if(evalReduction > null_move_max_eval_reduction) {
+        evalReduction = null_move_max_eval_reduction;
+    }
+
+    return null_move_base_reduction + depth / null_move_depth_divisor + evalReduction;
+}
+
+static bool MoveIsQuiet(BoardInfo_t* boardInfo, Move_t move) {
+    SpecialFlag_t flag = ReadSpecialFlag(move);
+    if(flag == en_passant_flag || flag == promotion_flag) {
+        return false;
+    }
+
+    return PieceOnSquare(boardInfo, ReadToSquare(move)) == none_type;
+}
+
+// Late quiet moves at shallow depth are unlikely enough to matter that they aren't searched at all.
+// Only done once some move has been searched and isn't getting mated, so we never prune our way into a mate.
+static bool LateMoveCanBePruned(
+    bool isPvNode,
+    bool inCheck,
+    bool isQuiet,
+    Depth_t depth,
+    int moveIndex,
+    EvalScore_t bestScore
+)
+{
+    return
+        !isPvNode &&
+        !inCheck &&
+        isQuiet &&
+        depth <= lmp_max_depth &&
+        moveIndex >= lmp_base_move_count + depth * depth &&
+        bestScore > -MATE_THRESHOLD;
+}
+
+static bool MoveCanBeReduced(bool inCheck, bool isQuiet, Depth_t depth, int moveIndex) {
+    return !inCheck && isQuiet && depth >= lmr_min_depth && moveIndex >= lmr_first_reduced_move;
+}
+
+// moves with a good history, including what they did after the last two moves, are reduced less
+static Depth_t LateMoveReduction(Depth_t depth, int moveIndex, bool isPvNode, bool givesCheck, HistoryScore_t quietHistory) {
+    int reduction = lateMoveReductions[depth][moveIndex];
+    reduction -= isPvNode;
+    reduction -= givesCheck;
+    reduction -= quietHistory / lmr_history_divisor;
+
+    // always leave at least one ply before the quiescence search
+    int maxReduction = depth - 2;
+    if(reduction > maxReduction) {
+        reduction = maxReduction;
+    }
+
+    return (reduction > 0) ? reduction : 0;
+}
+
+// Extensions are capped so a line of checks can't run the search past the end of the stacks.
+static bool ExtensionIsAllowed(ChessSearchInfo_t* searchInfo, Ply_t ply) {
+    return ply < extension_ply_multiplier * searchInfo->rootDepth && ply < PLY_MAX / 2;
+}
+
+// A TT move that failed high deep enough is tested for singularity: if no other move comes close
+// to its score in a reduced search, it's the only move holding the position together and gets extended.
+static bool SingularTestIsAllowed(
+    bool isRoot,
+    bool hasExcludedMove,
+    TTEntry_t* ttEntry,
+    EvalScore_t ttScore,
+    Depth_t depth
+)
+{
+    return
+        !isRoot &&
+        !hasExcludedMove &&
+        depth >= singular_min_depth &&
+        ttEntry->bound != upper_bound &&
+        ttEntry->depth + singular_tt_depth_margin >= depth &&
+        ttScore > -MATE_THRESHOLD && ttScore < MATE_THRESHOLD;
+}
+
+static HistoryScore_t HistoryBonus(Depth_t depth) {
+    HistoryScore_t bonus = history_bonus_scale * depth * depth;
+    return (bonus < history_max_bonus) ? bonus : history_max_bonus;
+}
+
+// the quiet move that caused a cutoff is rewarded, and every quiet searched before it failed to, so those are punished
+static void UpdateQuietOrdering(
+    MoveOrderingInfo_t* orderingInfo,
+    BoardInfo_t* boardInfo,
+    SearchStackEntry_t* searchStack,
+    Move_t cutoffMove,
+    Move_t* quietsSearched,
+    int numQuietsSearched,
+    Depth_t depth,
+    Ply_t ply
+)
+{
+    HistoryScore_t bonus = HistoryBonus(depth);
+
+    AddKillerMove(orderingInfo, cutoffMove, ply);
+    SetCounterMove(orderingInfo, boardInfo->colorToMove, searchStack, ply, cutoffMove);
+    UpdateQuietHistory(orderingInfo, boardInfo, searchStack, ply, cutoffMove, bonus);
+    for(int i = 0; i < numQuietsSearched; i++) {
+        UpdateQuietHistory(orderingInfo, boardInfo, searchStack, ply, quietsSearched[i], -bonus);
+    }
+}
+
 static EvalScore_t QSearch(
     BoardInfo_t* boardInfo,
     GameStack_t* gameStack,
@@ -59,43 +424,51 @@ static EvalScore_t QSearch(
     ChessSearchInfo_t* searchInfo,
     EvalScore_t alpha,
     EvalScore_t beta,
-    Ply_t ply
+    Ply_t ply,
+    bool searchQuietChecks
 )
 {
-    if(ShouldCheckTimer(searchInfo->nodeCount) && TimerExpired(&globalTimer)) {
+    if(SearchShouldStop(searchInfo)) {
         searchInfo->outOfTime = true;
         return 0;
     }
 
-    MoveList_t moveList;
-    CompleteMovegen(&moveList, boardInfo, gameStack);
-
-    GameEndStatus_t gameEndStatus = CheckForMates(boardInfo, moveList.maxIndex);
-    switch (gameEndStatus) {
-        case checkmate:
-            return -EVAL_MAX + ply;
-        case draw:
-            return 0;
+    if(ply >= PLY_MAX - 1) {
+        return ScoreOfPosition(boardInfo, gameStack, &searchInfo->evalInfo);
     }
 
-    EvalScore_t standPat = ScoreOfPosition(boardInfo);
-    if(standPat >= beta) {
-        return standPat;
-    }
+    // quiet checks only on the first ply, any deeper and the checks and evasions can go on for a long time
+    MovePicker_t picker;
+    InitCapturePicker(&picker, boardInfo, gameStack, searchQuietChecks);
+    const bool inCheck = picker.movegenInfo.inCheck;
 
-    if(standPat > alpha) {
-        alpha = standPat;
+    // In check there's no standing pat, every evasion gets searched and having none is mate.
+    // Captures alone can't tell a stalemate apart from a quiet position, so that is never detected here.
+    EvalScore_t bestScore = -EVAL_MAX + ply;
+    if(!inCheck) {
+        EvalScore_t standPat = ScoreOfPosition(boardInfo, gameStack, &searchInfo->evalInfo);
+        if(standPat >= beta) {
+            return standPat;
+        }
+
+        if(standPat > alpha) {
+            alpha = standPat;
+        }
+
+        bestScore = standPat;
     }
 
-    SortMoveList(&moveList, boardInfo);
+    Move_t move;
+    while(NextMove(&picker, &move)) {
+        // captures that lose material in the exchange can't raise the stand pat score, and neither can checks that hang the checker
+        if(!inCheck && !SEEPassesThreshold(boardInfo, move, 0)) {
+            continue;
+        }
 
-    EvalScore_t bestScore = standPat;
-    for(int i = 0; i <= moveList.maxCapturesIndex; i++) {
-        searchInfo->nodeCount++;
-        Move_t move = moveList.moves[i];
+        CountNode(searchInfo);
         MakeAndAddHash(boardInfo, gameStack, move, zobristStack);
 
-        EvalScore_t score = -QSearch(boardInfo, gameStack, zobristStack, searchInfo, -beta, -alpha, ply+1);
+        EvalScore_t score = -QSearch(boardInfo, gameStack, zobristStack, searchInfo, -beta, -alpha, ply+1, false);
 
         UnmakeAndRemoveHash(boardInfo, gameStack, zobristStack);
 
@@ -126,69 +499,263 @@ static EvalScore_t Negamax(
     EvalScore_t alpha,
     EvalScore_t beta,
     Depth_t depth,
-    Ply_t ply
+    Ply_t ply,
+    bool canNullMove
 )
 {
     const bool isRoot = ply == 0;
+    // widened in 64 bits, the full window is wider than an int32 can hold
+    const bool isPvNode = (int64_t)beta - alpha > 1;
 
-    if(ShouldCheckTimer(searchInfo->nodeCount) && TimerExpired(&globalTimer)) {
+    const Move_t excludedMove = searchInfo->excludedMoves[ply];
+    const bool hasExcludedMove = excludedMove.data != 0;
+
+    // with moves excluded the result isn't the position's real score, so it can't go in the TT
+    const bool canStoreInTT = (!isRoot || searchInfo->numExcludedRootMoves == 0) && !hasExcludedMove;
+
+    if(SearchShouldStop(searchInfo)) {
         searchInfo->outOfTime = true;
         return 0;
     }
 
     PvLengthInit(&searchInfo->pvTable, ply);
 
+    if(isRoot) {
+        searchInfo->rootDepth = depth;
+    }
+
     if(depth == 0) {
-        return QSearch(boardInfo, gameStack, zobristStack, searchInfo, alpha, beta, ply);
+        return QSearch(boardInfo, gameStack, zobristStack, searchInfo, alpha, beta, ply, true);
     }
 
-    MoveList_t moveList;
-    CompleteMovegen(&moveList, boardInfo, gameStack);
+    // checkmate and stalemate need the legal moves, so they are only found once the move loop comes up empty
+    if(!isRoot && PositionIsDrawn(boardInfo, gameStack, zobristStack)) {
+        return 0;
+    }
+
+    if(ply >= PLY_MAX - 1) {
+        return ScoreOfPosition(boardInfo, gameStack, &searchInfo->evalInfo);
+    }
 
+    // Mate distance pruning: even mating right now can't beat a shorter mate already found higher up the tree.
     if(!isRoot) {
-        GameEndStatus_t gameEndStatus = CurrentGameEndStatus(boardInfo, gameStack, zobristStack, moveList.maxIndex);
-        switch (gameEndStatus) {
-            case checkmate:
-                return -EVAL_MAX + ply;
-            case draw:
-                return 0;
+        EvalScore_t matedScore = -EVAL_MAX + ply;
+        EvalScore_t matingScore = EVAL_MAX - ply - 1;
+        alpha = (alpha > matedScore) ? alpha : matedScore;
+        beta = (beta < matingScore) ? beta : matingScore;
+        if(alpha >= beta) {
+            return alpha;
         }
     }
 
-    SortMoveList(&moveList, boardInfo);
+    ZobristHash_t hash = CurrentHash(zobristStack);
+    Move_t ttMove;
+    InitMove(&ttMove);
+
+    TTEntry_t ttEntry;
+    EvalScore_t ttScore = 0;
+    bool ttHit = TTProbe(hash, &ttEntry);
+    if(ttHit) {
+        ttScore = ScoreFromTT(ttEntry.score, ply);
+        if(!isPvNode && !hasExcludedMove && TTCutoffIsValid(ttEntry, ttScore, alpha, beta, depth)) {
+            return ttScore;
+        }
+
+        ttMove = ttEntry.bestMove;
+    }
+
+    MovePicker_t picker;
+    InitMovePicker(&picker, boardInfo, gameStack, &searchInfo->orderingInfo, searchInfo->searchStack, ttMove, ply);
+    const bool inCheck = picker.movegenInfo.inCheck;
+
+    // Null move pruning: if we can pass the turn and a reduced search still fails high, a real move almost certainly
+    // would too. Two null moves in a row would just hand the turn back, so the child isn't allowed to null move.
+    if(!hasExcludedMove && NullMoveIsAllowed(boardInfo, isPvNode, inCheck, canNullMove, depth)) {
+        EvalScore_t staticEval = ScoreOfPosition(boardInfo, gameStack, &searchInfo->evalInfo);
+        if(staticEval >= beta) {
+            int reducedDepth = depth - 1 - NullMoveReduction(depth, staticEval, beta);
+            Depth_t nullDepth = (reducedDepth > 0) ? reducedDepth : 0;
+
+            searchInfo->searchStack[ply].movedPiece = none_type;
+            MakeNullAndAddHash(boardInfo, gameStack, zobristStack);
+            EvalScore_t nullScore = -Negamax(boardInfo, gameStack, zobristStack, searchInfo, -beta, -beta+1, nullDepth, ply+1, false);
+            UnmakeNullAndRemoveHash(boardInfo, gameStack, zobristStack);
+
+            if(searchInfo->outOfTime) {
+                return 0;
+            }
+
+            if(nullScore >= beta) {
+                // a mate found after passing isn't a real mate
+                if(nullScore > MATE_THRESHOLD) {
+                    nullScore = beta;
+                }
+
+                if(depth < null_move_verification_depth) {
+                    return nullScore;
+                }
+
+                // deep enough that a zugzwang mistake is expensive, so confirm with a normal reduced search
+                EvalScore_t verifyScore = Negamax(boardInfo, gameStack, zobristStack, searchInfo, beta-1, beta, nullDepth, ply, false);
+                if(searchInfo->outOfTime) {
+                    return 0;
+                }
+
+                if(verifyScore >= beta) {
+                    return nullScore;
+                }
+            }
+        }
+    }
 
+    const EvalScore_t oldAlpha = alpha;
     EvalScore_t bestScore = -EVAL_MAX;
-    for(int i = 0; i <= moveList.maxIndex; i++) {
-        Move_t move = moveList.moves[i];
+    Move_t bestMove;
+    InitMove(&bestMove);
+
+    Move_t quietsSearched[MOVELIST_MAX];
+    int numQuietsSearched = 0;
+
+    const bool canExtend = ExtensionIsAllowed(searchInfo, ply);
+    const bool canTestSingular = canExtend && ttHit && SingularTestIsAllowed(isRoot, hasExcludedMove, &ttEntry, ttScore, depth);
+
+    // a forced reply doesn't cost the opponent anything to search one ply deeper
+    const bool hasSingleReply = canExtend && inCheck && CountEvasions(&picker) == 1;
+
+    Move_t move;
+    int numMoves = 0;
+    while(NextMove(&picker, &move)) {
+        if(isRoot && IsExcludedRootMove(searchInfo, move)) {
+            continue;
+        }
+
+        if(hasExcludedMove && SameMove(move, excludedMove)) {
+            continue;
+        }
+
+        // Only one ply of extension per move, whichever reason gives it.
+        Depth_t extension = hasSingleReply;
+        if(canTestSingular && !extension && SameMove(move, ttMove)) {
+            EvalScore_t singularBeta = ttScore - singular_margin_per_depth * depth;
+            Depth_t singularDepth = (depth - 1) / 2;
+
+            searchInfo->excludedMoves[ply] = move;
+            EvalScore_t singularScore = Negamax(boardInfo, gameStack, zobristStack, searchInfo, singularBeta-1, singularBeta, singularDepth, ply, false);
+            InitMove(&searchInfo->excludedMoves[ply]);
+
+            if(searchInfo->outOfTime) {
+                return 0;
+            }
+
+            extension = singularScore < singularBeta;
+        }
+
+        const int moveIndex = numMoves++;
+        const bool isQuiet = MoveIsQuiet(boardInfo, move);
+
+        // every quiet after this one would be pruned too, so don't bother generating them
+        if(LateMoveCanBePruned(isPvNode, inCheck, isQuiet, depth, moveIndex, bestScore)) {
+            SkipQuietMoves(&picker);
+            continue;
+        }
+
+        HistoryScore_t quietHistory = 0;
+        if(isQuiet) {
+            quietHistory = ReadQuietHistory(&searchInfo->orderingInfo, boardInfo, searchInfo->searchStack, ply, move);
+        }
+
+        searchInfo->searchStack[ply].movedPiece = PieceOnSquare(boardInfo, ReadFromSquare(move));
+        searchInfo->searchStack[ply].toSquare = ReadToSquare(move);
         MakeAndAddHash(boardInfo, gameStack, move, zobristStack);
 
-        EvalScore_t score = -Negamax(boardInfo, gameStack, zobristStack, searchInfo, -beta, -alpha, depth-1, ply+1);
+        const bool givesCheck = SideToMoveInCheck(boardInfo);
+        if(canExtend && givesCheck) {
+            extension = 1;
+        }
+        const Depth_t newDepth = depth - 1 + extension;
+
+        // Principal variation search: the first move gets the full window, the rest only have to prove
+        // they can't beat alpha with a zero window search, and are re-searched if that guess turns out wrong.
+        // Late quiet moves are scouted at a reduced depth first, and get the full depth back if they beat alpha.
+        EvalScore_t score;
+        if(moveIndex == 0) {
+            score = -Negamax(boardInfo, gameStack, zobristStack, searchInfo, -beta, -alpha, newDepth, ply+1, true);
+        } else {
+            Depth_t reduction = 0;
+            if(!extension && MoveCanBeReduced(inCheck, isQuiet, depth, moveIndex)) {
+                reduction = LateMoveReduction(depth, moveIndex, isPvNode, givesCheck, quietHistory);
+            }
+
+            score = -Negamax(boardInfo, gameStack, zobristStack, searchInfo, -alpha-1, -alpha, newDepth-reduction, ply+1, true);
+            if(score > alpha && reduction > 0) {
+                score = -Negamax(boardInfo, gameStack, zobristStack, searchInfo, -alpha-1, -alpha, newDepth, ply+1, true);
+            }
+
+            if(score > alpha && score < beta) {
+                score = -Negamax(boardInfo, gameStack, zobristStack, searchInfo, -beta, -alpha, newDepth, ply+1, true);
+            }
+        }
 
         UnmakeAndRemoveHash(boardInfo, gameStack, zobristStack);
 
-        searchInfo->nodeCount++;
+        CountNode(searchInfo);
 
         if(searchInfo->outOfTime) {
             return 0;
         }
 
-        if(score >= beta) {
-            return score;
-        }
-
         if(score > bestScore) {
             bestScore = score;
             if(score > alpha) {
                 alpha = score;
+                bestMove = move;
                 UpdatePvTable(&searchInfo->pvTable, move, ply);
             }
         }
+
+        if(score >= beta) {
+            if(isQuiet) {
+                UpdateQuietOrdering(
+                    &searchInfo->orderingInfo,
+                    boardInfo,
+                    searchInfo->searchStack,
+                    move,
+                    quietsSearched,
+                    numQuietsSearched,
+                    depth,
+                    ply
+                );
+            }
+
+            if(canStoreInTT) {
+                TTStore(hash, move, ScoreToTT(score, ply), depth, lower_bound);
+            }
+            return score;
+        }
+
+        if(isQuiet) {
+            quietsSearched[numQuietsSearched] = move;
+            numQuietsSearched++;
+        }
+    }
+
+    // with the only legal move excluded, the verification search has nothing to say about the position
+    if(numMoves == 0) {
+        if(hasExcludedMove) {
+            return alpha;
+        }
+        return inCheck ? -EVAL_MAX + ply : 0;
+    }
+
+    if(canStoreInTT) {
+        Bound_t bound = (alpha > oldAlpha) ? exact_bound : upper_bound;
+        TTStore(hash, bestMove, ScoreToTT(bestScore, ply), depth, bound);
     }
 
     return bestScore;
 }
 
-static void SetupGlobalTimer(UciSearchInfo_t* uciSearchInfo, BoardInfo_t* boardInfo) {
+static void SetupTimeManager(UciSearchInfo_t* uciSearchInfo, BoardInfo_t* boardInfo) {
     Milliseconds_t totalTime;
     Milliseconds_t increment;
     if(boardInfo->colorToMove == white) {
@@ -199,126 +766,428 @@ static void SetupGlobalTimer(UciSearchInfo_t* uciSearchInfo, BoardInfo_t* boardI
         increment = uciSearchInfo->bInc;
     }
 
-    Milliseconds_t timeToUse;
+    if(uciSearchInfo->infinite || (uciSearchInfo->forceTime == 0 && totalTime == 0)) {
+        timeManager.isTimed = false;
+        timeManager.isManaged = false;
+        return;
+    }
+
+    timeManager.isTimed = true;
     if(uciSearchInfo->forceTime) {
-        timeToUse = uciSearchInfo->forceTime;
-    } else {
-        timeToUse = (totalTime + increment/2) / time_fraction;
+        timeManager.isManaged = false;
+        timeManager.softLimit = uciSearchInfo->forceTime - uciSearchInfo->overhead;
+        TimerInit(&timeManager.hardTimer, timeManager.softLimit);
+        return;
+    }
+
+    Milliseconds_t available = totalTime - uciSearchInfo->overhead;
+    if(available < 1) {
+        available = 1;
+    }
+
+    int movesToGo = default_moves_to_go;
+    if(uciSearchInfo->movesToGo > 0) {
+        movesToGo = (uciSearchInfo->movesToGo < max_moves_to_go) ? uciSearchInfo->movesToGo : max_moves_to_go;
+    }
+
+    Milliseconds_t softLimit = available / movesToGo + increment * increment_usage_percent / 100;
+    Milliseconds_t hardLimit = softLimit * hard_limit_multiplier;
+    Milliseconds_t maxHardLimit = available * hard_limit_max_percent / 100;
+    if(hardLimit > maxHardLimit) {
+        hardLimit = maxHardLimit;
     }
+    if(softLimit > hardLimit) {
+        softLimit = hardLimit;
+    }
+
+    timeManager.isManaged = uciSearchInfo->depthLimit == 0 && uciSearchInfo->nodeLimit == 0;
+    timeManager.softLimit = softLimit;
+    TimerInit(&timeManager.hardTimer, hardLimit);
+}
+
+// An unstable best move or a falling score means this position needs more thought, a best move
+// that has survived several iterations means it probably won't change with one more.
+static bool SoftLimitReached(
+    ChessSearchInfo_t* searchInfo,
+    Stopwatch_t* stopwatch,
+    int stableIterations,
+    EvalScore_t scoreDrop
+)
+{
+    if(!timeManager.isManaged || atomic_load(searchInfo->pondering)) {
+        return false;
+    }
+
+    if(scoreDrop < 0) {
+        scoreDrop = 0;
+    } else if(scoreDrop > score_drop_max) {
+        scoreDrop = score_drop_max;
+    }
+
+    Milliseconds_t scaledLimit = timeManager.softLimit * stabilityScale[stableIterations] / 1000;
+    scaledLimit = scaledLimit * (1000 + scoreDrop * score_drop_scale) / 1000;
 
-    TimerInit(&globalTimer, timeToUse - uciSearchInfo->overhead);
+    return ElapsedTime(stopwatch) >= scaledLimit;
+}
+
+static void CopyRootLine(RootLine_t* line, PvTable_t* pvTable, EvalScore_t score) {
+    line->score = score;
+    line->pvLength = pvTable->pvLength[0];
+    for(int i = 0; i < line->pvLength; i++) {
+        line->pv[i] = pvTable->moveMatrix[0][i];
+    }
 }
 
 static void PrintUciInformation(
-    ChessSearchInfo_t searchInfo,
-    SearchResults_t searchResults,
+    RootLine_t* line,
+    const char* boundType,
     Depth_t currentDepth,
+    int multiPv,
     Stopwatch_t* stopwatch
 )
 {
     const char* scoreType = NO_MATE;
-    EvalScore_t scoreValue = searchResults.score;
+    EvalScore_t scoreValue = line->score;
 
-    if(searchResults.score > MATE_THRESHOLD) {
+    if(line->score > MATE_THRESHOLD) {
         scoreType = MATING;
-        Ply_t ply = EVAL_MAX - searchResults.score;
+        Ply_t ply = EVAL_MAX - line->score;
         scoreValue = (ply + 1)/2;
 
-    } else if(searchResults.score < -MATE_THRESHOLD) {
+    } else if(line->score < -MATE_THRESHOLD) {
         scoreType = MATED;
-        Ply_t ply = EVAL_MAX + searchResults.score;
+        Ply_t ply = EVAL_MAX + line->score;
         scoreValue = (ply + 1)/2;
     }
 
+    NodeCount_t nodeCount = TotalNodeCount();
+    Milliseconds_t elapsed = ElapsedTime(stopwatch);
+    Milliseconds_t msecForNps = (elapsed > 0) ? elapsed : 1;
+
+    // GUIs expect a line's score and its moves on the same info line, so the PV goes in the same printf
+    char pvString[PV_STRING_MAX];
+    WritePvString(pvString, line->pv, line->pvLength);
+
     SendUciInfoString(
-        "score %s%d depth %d nodes %lld time %lld",
+        "multipv %d score %s%d%s depth %d nodes %lld time %lld nps %lld hashfull %d%s",
+        multiPv,
         scoreType,
         scoreValue,
+        boundType,
         currentDepth,
-        (long long)searchInfo.nodeCount,
-        (long long)ElapsedTime(stopwatch)
+        (long long)nodeCount,
+        (long long)elapsed,
+        (long long)(nodeCount * msec_per_sec / msecForNps),
+        TTHashfull(),
+        pvString
     );
+}
+
+static void ResizeThreadPool(int numThreads) {
+    if(numThreads == threadPoolSize) {
+        return;
+    }
+
+    // every thread carries its own pawn table, accumulators and histories, so a large Threads value can run out of memory
+    free(threadPool);
+    threadPool = aligned_alloc(alignof(SearchThread_t), numThreads * sizeof(*threadPool)); // the NNUE accumulators want 32 byte alignment
+
+    if(threadPool == NULL) {
+        printf("info string failed to allocate %d search threads, falling back to 1\n", numThreads);
+        numThreads = 1;
+        threadPool = aligned_alloc(alignof(SearchThread_t), sizeof(*threadPool));
+    }
 
-    SendPvInfo(&searchInfo.pvTable, currentDepth);
+    assert(threadPool != NULL);
+    threadPoolSize = numThreads;
+
+    for(int i = 0; i < threadPoolSize; i++) {
+        ClearEvaluationInfo(&threadPool[i].searchInfo.evalInfo);
+    }
 }
 
-SearchResults_t Search(
+static void InitSearchThread(
+    SearchThread_t* thread,
+    int threadId,
     UciSearchInfo_t* uciSearchInfo,
     BoardInfo_t* boardInfo,
     GameStack_t* gameStack,
-    ZobristStack_t* zobristStack,
+    ZobristStack_t* zobristStack
+)
+{
+    thread->threadId = threadId;
+    thread->boardInfo = *boardInfo;
+    thread->gameStack = *gameStack;
+    thread->zobristStack = *zobristStack;
+    InitSearchInfo(&thread->searchInfo, uciSearchInfo, threadId == 0);
+}
+
+static void ReportBound(
+    ChessSearchInfo_t* searchInfo,
+    EvalScore_t score,
+    const char* boundType,
+    Depth_t depth,
+    Stopwatch_t* stopwatch
+)
+{
+    RootLine_t boundLine;
+    CopyRootLine(&boundLine, &searchInfo->pvTable, score);
+
+    // the line being searched is the one after every line that's already excluded
+    PrintUciInformation(&boundLine, boundType, depth, searchInfo->numExcludedRootMoves + 1, stopwatch);
+}
+
+// Searches with a narrow window around the last iteration's score, widening it every time the score falls outside.
+// Bounds are only reported when printUciInfo is set, which is only ever true for the main thread.
+static EvalScore_t AspirationWindowSearch(
+    SearchThread_t* thread,
+    EvalScore_t previousScore,
+    Depth_t depth,
+    Stopwatch_t* stopwatch,
     bool printUciInfo
 )
 {
-    Stopwatch_t stopwatch;
-    StopwatchInit(&stopwatch);
-    SetupGlobalTimer(uciSearchInfo, boardInfo);
+    ChessSearchInfo_t* searchInfo = &thread->searchInfo;
 
-    ChessSearchInfo_t searchInfo;
-    InitSearchInfo(&searchInfo);
+    EvalScore_t delta = aspiration_initial_delta;
+    EvalScore_t alpha = -EVAL_INFINITY;
+    EvalScore_t beta = EVAL_INFINITY;
+    if(depth >= aspiration_min_depth) {
+        alpha = previousScore - delta;
+        beta = previousScore + delta;
+    }
+
+    while(true) {
+        EvalScore_t score = Negamax(
+            &thread->boardInfo,
+            &thread->gameStack,
+            &thread->zobristStack,
+            searchInfo,
+            alpha,
+            beta,
+            depth,
+            0,
+            true
+        );
+
+        if(searchInfo->outOfTime) {
+            return 0;
+        }
+
+        if(score <= alpha) {
+            if(printUciInfo) {
+                ReportBound(searchInfo, score, UPPERBOUND, depth, stopwatch);
+            }
+
+            beta = (alpha + beta) / 2;
+            alpha = score - delta;
+        } else if(score >= beta) {
+            if(printUciInfo) {
+                ReportBound(searchInfo, score, LOWERBOUND, depth, stopwatch);
+            }
+
+            beta = score + delta;
+        } else {
+            return score;
+        }
+
+        delta += delta;
+        if(delta > aspiration_max_delta) {
+            alpha = -EVAL_INFINITY;
+            beta = EVAL_INFINITY;
+        }
+    }
+}
+
+// The GUI can send a stop before the first iteration is done, and a null bestmove is illegal,
+// so the first legal move is kept to fall back on. It stays a null move when there are no legal moves.
+static int CountLegalRootMoves(SearchThread_t* thread, Move_t* fallbackMove) {
+    MoveList_t moveList;
+    CompleteMovegen(&moveList, &thread->boardInfo, &thread->gameStack);
+
+    InitMove(fallbackMove);
+    if(moveList.maxIndex != movelist_empty) {
+        *fallbackMove = moveList.moves[0];
+    }
+
+    return moveList.maxIndex + 1;
+}
+
+// never more lines than there are legal moves, but always at least one so there's a search to report
+static int NumberOfRootLines(int numLegalMoves, int multiPv) {
+    if(multiPv > numLegalMoves) {
+        multiPv = numLegalMoves;
+    }
+
+    return (multiPv > 0) ? multiPv : 1;
+}
+
+static void* HelperThreadSearch(void* arg) {
+    SearchThread_t* thread = arg;
+    ChessSearchInfo_t* searchInfo = &thread->searchInfo;
+
+    // half of the helpers start a ply ahead so they aren't all searching the same iteration as the main thread
+    Depth_t currentDepth = thread->threadId % 2;
+    EvalScore_t score = 0;
+    while(!searchInfo->outOfTime && currentDepth < DEPTH_MAX) {
+        currentDepth++;
+        score = AspirationWindowSearch(thread, score, currentDepth, NULL, false);
+    }
+
+    return NULL;
+}
+
+static SearchResults_t MainThreadSearch(
+    SearchThread_t* thread,
+    UciSearchInfo_t* uciSearchInfo,
+    Stopwatch_t* stopwatch,
+    bool printUciInfo
+)
+{
+    ChessSearchInfo_t* searchInfo = &thread->searchInfo;
 
     SearchResults_t searchResults;
+    searchResults.score = 0;
+    InitMove(&searchResults.ponderMove);
+
+    int numLegalMoves = CountLegalRootMoves(thread, &searchResults.bestMove);
+    int numLines = NumberOfRootLines(numLegalMoves, uciSearchInfo->multiPv);
+    for(int i = 0; i < numLines; i++) {
+        rootLines[i].score = 0;
+    }
+
     Depth_t currentDepth = 0;
+    int stableIterations = 0;
     do {
         currentDepth++;
+        Move_t previousBestMove = searchResults.bestMove;
+        EvalScore_t previousScore = searchResults.score;
 
-        EvalScore_t score = Negamax(
-            boardInfo,
-            gameStack,
-            zobristStack,
-            &searchInfo,
-            -INFINITY,
-            INFINITY,
-            currentDepth,
-            0
-        );
+        // MultiPV: every line searches the root again without the best moves of the lines before it
+        for(int lineIndex = 0; lineIndex < numLines; lineIndex++) {
+            RootLine_t* line = &rootLines[lineIndex];
+            searchInfo->numExcludedRootMoves = lineIndex;
+
+            EvalScore_t score = AspirationWindowSearch(thread, line->score, currentDepth, stopwatch, printUciInfo);
+            if(searchInfo->outOfTime) {
+                break;
+            }
 
-        if(!searchInfo.outOfTime) {
-            searchResults.bestMove = PvTableBestMove(&searchInfo.pvTable);
-            searchResults.score = score;
+            CopyRootLine(line, &searchInfo->pvTable, score);
+            searchInfo->excludedRootMoves[lineIndex] = PvTableBestMove(&searchInfo->pvTable);
+
+            if(lineIndex == 0) {
+                searchInfo->hasResult = true;
+                searchResults.bestMove = PvTableBestMove(&searchInfo->pvTable);
+                searchResults.score = score;
+
+                InitMove(&searchResults.ponderMove);
+                if(line->pvLength > 1) {
+                    searchResults.ponderMove = line->pv[1];
+                }
+            }
 
             if(printUciInfo) {
-                PrintUciInformation(searchInfo, searchResults, currentDepth, &stopwatch);
+                PrintUciInformation(line, NO_BOUND, currentDepth, lineIndex + 1, stopwatch);
+            }
+        }
+
+        if(searchInfo->outOfTime) {
+            break;
+        }
+
+        // nothing to think about, so save the clock for later
+        if(numLegalMoves == 1 && timeManager.isManaged) {
+            break;
+        }
+
+        if(currentDepth > 1) {
+            if(SameMove(searchResults.bestMove, previousBestMove)) {
+                stableIterations += (stableIterations < stable_iterations_max);
+            } else {
+                stableIterations = 0;
+            }
+
+            if(SoftLimitReached(searchInfo, stopwatch, stableIterations, previousScore - searchResults.score)) {
+                break;
             }
         }
 
-    } while(!searchInfo.outOfTime && currentDepth != uciSearchInfo->depthLimit && currentDepth < DEPTH_MAX);
+    } while(!searchInfo->outOfTime && currentDepth != uciSearchInfo->depthLimit && currentDepth < DEPTH_MAX);
 
     return searchResults;
 }
 
-NodeCount_t BenchSearch(
+static bool SearchMustWaitForGui(UciSearchInfo_t* uciSearchInfo) {
+    if(atomic_load(&uciSearchInfo->stopSignal)) {
+        return false;
+    }
+
+    return uciSearchInfo->infinite || atomic_load(&uciSearchInfo->pondering);
+}
+
+SearchResults_t Search(
+    UciSearchInfo_t* uciSearchInfo,
     BoardInfo_t* boardInfo,
     GameStack_t* gameStack,
     ZobristStack_t* zobristStack,
-    Depth_t depth
+    bool printUciInfo
 )
 {
-    UciSearchInfo_t dummySearchInfo;
-    UciSearchInfoInit(&dummySearchInfo);
-    dummySearchInfo.forceTime = 1000000;
-    SetupGlobalTimer(&dummySearchInfo, boardInfo);
-    
-    ChessSearchInfo_t searchInfo;
-    InitSearchInfo(&searchInfo);
+    Stopwatch_t stopwatch;
+    StopwatchInit(&stopwatch);
+    SetupTimeManager(uciSearchInfo, boardInfo);
+    TTNewSearch();
 
-    Depth_t currentDepth = 0;
-    do {
-        currentDepth++;
+    ResizeThreadPool(uciSearchInfo->threads);
 
-        Negamax(
-            boardInfo,
-            gameStack,
-            zobristStack,
-            &searchInfo,
-            -INFINITY,
-            INFINITY,
-            currentDepth,
-            0
-        );
-    } while(currentDepth < depth);
+    for(int i = 0; i < threadPoolSize; i++) {
+        InitSearchThread(&threadPool[i], i, uciSearchInfo, boardInfo, gameStack, zobristStack);
+    }
 
-    return searchInfo.nodeCount;
+    for(int i = 1; i < threadPoolSize; i++) {
+        pthread_create(&threadPool[i].handle, NULL, HelperThreadSearch, &threadPool[i]);
+    }
+
+    SearchResults_t searchResults = MainThreadSearch(&threadPool[0], uciSearchInfo, &stopwatch, printUciInfo);
+
+    // UCI doesn't allow a bestmove during ponder or infinite searches until the GUI asks for it
+    while(SearchMustWaitForGui(uciSearchInfo)) {
+        nanosleep(&gui_poll_interval, NULL);
+    }
+
+    atomic_store(&uciSearchInfo->stopSignal, true);
+    for(int i = 1; i < threadPoolSize; i++) {
+        pthread_join(threadPool[i].handle, NULL);
+    }
+
+    searchResults.nodeCount = TotalNodeCount();
+    return searchResults;
+}
+
+NodeCount_t BenchSearch(
+    BoardInfo_t* boardInfo,
+    GameStack_t* gameStack,
+    ZobristStack_t* zobristStack,
+    Depth_t depth,
+    int threads
+)
+{
+    UciSearchInfo_t benchSearchInfo;
+    UciSearchInfoInit(&benchSearchInfo);
+    benchSearchInfo.depthLimit = depth; // no clock, so the node count only depends on the positions and the depth
+    benchSearchInfo.threads = threads;
+
+    SearchResults_t searchResults = Search(&benchSearchInfo, boardInfo, gameStack, zobristStack, false);
+    return searchResults.nodeCount;
+}
+
+void InitSearchTables() {
+    for(int depth = 1; depth <= DEPTH_MAX; depth++) {
+        for(int moveIndex = 1; moveIndex < MOVELIST_MAX; moveIndex++) {
+            lateMoveReductions[depth][moveIndex] = 0.75 + log(depth) * log(moveIndex + 1) / 2.25;
+        }
+    }
 }
 
 void UciSearchInfoTimeInfoReset(UciSearchInfo_t* uciSearchInfo) {
@@ -327,6 +1196,12 @@ void UciSearchInfoTimeInfoReset(UciSearchInfo_t* uciSearchInfo) {
     uciSearchInfo->wInc = 0;
     uciSearchInfo->bInc = 0;
     uciSearchInfo->forceTime = 0;
+    uciSearchInfo->movesToGo = 0;
+    uciSearchInfo->depthLimit = 0; // so a go depth doesn't stick around for the next go
+    uciSearchInfo->nodeLimit = 0;
+    uciSearchInfo->infinite = false;
+    atomic_store(&uciSearchInfo->stopSignal, false);
+    atomic_store(&uciSearchInfo->pondering, false);
 }
 
 void UciSearchInfoInit(UciSearchInfo_t* uciSearchInfo) {
@@ -335,7 +1210,15 @@ void UciSearchInfoInit(UciSearchInfo_t* uciSearchInfo) {
     uciSearchInfo->wInc = 0;
     uciSearchInfo->bInc = 0;
     uciSearchInfo->forceTime = 0;
+    uciSearchInfo->movesToGo = 0;
     uciSearchInfo->overhead = overhead_default_msec;
+    uciSearchInfo->threads = threads_default;
+    uciSearchInfo->multiPv = multipv_default;
+    uciSearchInfo->ponderEnabled = false;
+    uciSearchInfo->infinite = false;
 
     uciSearchInfo->depthLimit = 0;
+    uciSearchInfo->nodeLimit = 0;
+    atomic_store(&uciSearchInfo->stopSignal, false);
+    atomic_store(&uciSearchInfo->pondering, false);
 }
\ No newline at end of file
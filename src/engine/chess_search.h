@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <limits.h>
+#include <stdatomic.h>
 
 #include "move.h"
 #include "board_info.h"
@@ -20,6 +21,14 @@ enum UciSearchInfoOptions {
     overhead_default_msec = 50,
     overhead_min_msec = 1,
     overhead_max_msec = 128,
+
+    threads_default = 1,
+    threads_min = 1,
+    threads_max = 256,
+
+    multipv_default = 1,
+    multipv_min = 1,
+    multipv_max = 64,
 };
 
 typedef struct {
@@ -29,13 +38,29 @@ typedef struct {
     Milliseconds_t bInc;
     Milliseconds_t forceTime;
     Milliseconds_t overhead;
+    int movesToGo; // 0 when the GUI didn't send one, which means sudden death
+    int threads;
+    int multiPv; // how many of the best root moves get their own line
+    bool ponderEnabled; // the Ponder option, only changes whether bestmove suggests a move to ponder on
+    bool infinite;
 
     Depth_t depthLimit;
+    NodeCount_t nodeLimit; // 0 for no limit, otherwise counted over all threads
+
+    // raised by the UCI thread on stop/quit and by the search itself once it finishes.
+    // it has to be reset before the same search info is used for another search.
+    atomic_bool stopSignal;
+
+    // set by go ponder and cleared by ponderhit. While it's up the clock is ignored,
+    // and a search that finishes early holds on to its move until ponderhit or stop
+    atomic_bool pondering;
 } UciSearchInfo_t;
 
 typedef struct {
     Move_t bestMove;
+    Move_t ponderMove; // the reply the PV expects, empty if the PV is too short
     EvalScore_t score;
+    NodeCount_t nodeCount;
 } SearchResults_t;
 
 SearchResults_t Search(
@@ -50,9 +75,12 @@ NodeCount_t BenchSearch(
     BoardInfo_t* boardInfo,
     GameStack_t* gameStack,
     ZobristStack_t* zobristStack,
-    Depth_t depth
+    Depth_t depth,
+    int threads
 );
 
+void InitSearchTables();
+
 void UciSearchInfoTimeInfoReset(UciSearchInfo_t* uciSearchInfo);
 
 void UciSearchInfoInit(UciSearchInfo_t* uciSearchInfo);
@@ -17,64 +17,77 @@ static Centipawns_t midgamePST[6][NUM_SQUARES] = { KNIGHT_MG_PST, BISHOP_MG_PST,
 static Centipawns_t endgamePST[6][NUM_SQUARES] = { KNIGHT_EG_PST, BISHOP_EG_PST, ROOK_EG_PST, QUEEN_EG_PST, PAWN_EG_PST, KING_EG_PST };
 static Phase_t gamePhaseLookup[6] = GAMEPHASE_VALUES;
 
+static bool nnueEnabled = false;
+
 Centipawns_t ValueOfPiece(Piece_t piece) {
     return pieceValues[piece];
 }
 
-static void MaterialAndPST(
-    Bitboard_t infoField[2],
-    Piece_t piece,
-    Centipawns_t value,
-    Phase_t* gamePhase,
-    Centipawns_t* mgScore,
-    Centipawns_t* egScore
-)
-{
-    Bitboard_t whitePieces = infoField[white];
-    Bitboard_t blackPieces = infoField[black];
-
-    while(whitePieces) {
-        Square_t sq = MIRROR(LSB(whitePieces));
-        *mgScore += value + midgamePST[piece][sq];
-        *egScore += value + endgamePST[piece][sq];
-        *gamePhase += gamePhaseLookup[piece];
-        ResetLSB(&whitePieces);
-    }
-    while(blackPieces) {
-        Square_t sq = LSB(blackPieces);
-        *mgScore -= value + midgamePST[piece][sq];
-        *egScore -= value + endgamePST[piece][sq];
-        *gamePhase += gamePhaseLookup[piece];
-        ResetLSB(&blackPieces);
+PackedScore_t PackScore(Centipawns_t mgScore, Centipawns_t egScore) {
+    return (PackedScore_t)((uint32_t)mgScore << 16) + egScore;
+}
+
+static Centipawns_t MidgameScore(PackedScore_t score) {
+    return (int16_t)((uint32_t)(score + 0x8000) >> 16);
+}
+
+static Centipawns_t EndgameScore(PackedScore_t score) {
+    return (int16_t)(uint16_t)score;
+}
+
+static PackedScore_t PieceSquareScore(Piece_t piece, Color_t color, Square_t square) {
+    Centipawns_t value = pieceValues[piece];
+    if(color == white) {
+        Square_t sq = MIRROR(square);
+        return PackScore(value + midgamePST[piece][sq], value + endgamePST[piece][sq]);
     }
+
+    return -PackScore(value + midgamePST[piece][square], value + endgamePST[piece][square]);
 }
 
-static void AddKingPSTBonus(BoardInfo_t* boardInfo, Centipawns_t* mgScore, Centipawns_t* egScore) {
-    Square_t whiteKing = MIRROR(KingSquare(boardInfo, white));
-    Square_t blackKing = KingSquare(boardInfo, black);
+void AddPieceToScore(BoardInfo_t* boardInfo, Piece_t piece, Color_t color, Square_t square) {
+    boardInfo->materialAndPST += PieceSquareScore(piece, color, square);
+    boardInfo->phase += gamePhaseLookup[piece];
+}
 
-    *mgScore += midgamePST[king][whiteKing];
-    *egScore += endgamePST[king][whiteKing];
+void RemovePieceFromScore(BoardInfo_t* boardInfo, Piece_t piece, Color_t color, Square_t square) {
+    boardInfo->materialAndPST -= PieceSquareScore(piece, color, square);
+    boardInfo->phase -= gamePhaseLookup[piece];
+}
 
-    *mgScore -= midgamePST[king][blackKing];
-    *egScore -= endgamePST[king][blackKing];
+void MovePieceInScore(BoardInfo_t* boardInfo, Piece_t piece, Color_t color, Square_t fromSquare, Square_t toSquare) {
+    boardInfo->materialAndPST += PieceSquareScore(piece, color, toSquare) - PieceSquareScore(piece, color, fromSquare);
 }
 
-static Centipawns_t MaterialBalanceAndPSTBonus(BoardInfo_t* boardInfo) {
-    Centipawns_t mgScore = 0;
-    Centipawns_t egScore = 0;
-    Phase_t gamePhase = 0;
+void InitMaterialAndPST(BoardInfo_t* boardInfo) {
+    boardInfo->materialAndPST = 0;
+    boardInfo->phase = 0;
+
+    for(int color = white; color <= black; color++) {
+        for(Piece_t piece = knight; piece <= king; piece++) {
+            Bitboard_t pieces = *GetPieceInfoField(boardInfo, piece, color);
+            while(pieces) {
+                AddPieceToScore(boardInfo, piece, color, LSB(pieces));
+                ResetLSB(&pieces);
+            }
+        }
+    }
+}
+
+// only the assert in ScoreOfPosition uses it
+#ifndef NDEBUG
+static bool MaterialAndPSTIsUpToDate(BoardInfo_t* boardInfo) {
+    BoardInfo_t recomputed = *boardInfo;
+    InitMaterialAndPST(&recomputed);
 
-    MaterialAndPST(boardInfo->knights, knight, knight_value, &gamePhase, &mgScore, &egScore);
-    MaterialAndPST(boardInfo->bishops, bishop, bishop_value, &gamePhase, &mgScore, &egScore);
-    MaterialAndPST(boardInfo->rooks, rook, rook_value, &gamePhase, &mgScore, &egScore);
-    MaterialAndPST(boardInfo->queens, queen, queen_value, &gamePhase, &mgScore, &egScore);
-    MaterialAndPST(boardInfo->pawns, pawn, pawn_value, &gamePhase, &mgScore, &egScore);
-    AddKingPSTBonus(boardInfo, &mgScore, &egScore);
+    return recomputed.materialAndPST == boardInfo->materialAndPST && recomputed.phase == boardInfo->phase;
+}
+#endif
 
-    Phase_t mgPhase = (gamePhase < PHASE_MAX) ? gamePhase : PHASE_MAX;
+static Centipawns_t TaperedScore(PackedScore_t score, Phase_t phase) {
+    Phase_t mgPhase = (phase < PHASE_MAX) ? phase : PHASE_MAX;
     Phase_t egPhase = PHASE_MAX - mgPhase;
-    return (mgScore * mgPhase + egScore * egPhase) / PHASE_MAX; // weighted average
+    return (MidgameScore(score) * mgPhase + EndgameScore(score) * egPhase) / PHASE_MAX; // weighted average
 }
 
 static Centipawns_t MobilityEval(BoardInfo_t* boardInfo) {
@@ -85,9 +98,26 @@ static Centipawns_t MobilityEval(BoardInfo_t* boardInfo) {
     return (PopCount(whitePseudolegals) - PopCount(blackPseudolegals)) * mobility_weight;
 }
 
-EvalScore_t ScoreOfPosition(BoardInfo_t* boardInfo) {
+void ClearEvaluationInfo(EvaluationInfo_t* evalInfo) {
+    ClearPawnTable(&evalInfo->pawnTable);
+    ClearAccumulatorStack(&evalInfo->accumulatorStack);
+}
+
+void UseNNUE(bool enabled) {
+    nnueEnabled = enabled;
+}
+
+EvalScore_t ScoreOfPosition(BoardInfo_t* boardInfo, GameStack_t* gameStack, EvaluationInfo_t* evalInfo) {
+    if(nnueEnabled) {
+        return NNUEEvaluate(boardInfo, gameStack, &evalInfo->accumulatorStack);
+    }
+
+    assert(MaterialAndPSTIsUpToDate(boardInfo));
+
+    PackedScore_t score = boardInfo->materialAndPST + PawnStructureScore(&evalInfo->pawnTable, boardInfo, ReadPawnHash(gameStack));
+
     EvalScore_t eval = 0;
-    eval += MaterialBalanceAndPSTBonus(boardInfo);
+    eval += TaperedScore(score, boardInfo->phase);
     eval += MobilityEval(boardInfo);
 
     return boardInfo->colorToMove == white ? eval : -eval;
@@ -11,12 +11,14 @@
 #include "board_info.h"
 #include "game_state.h"
 #include "zobrist.h"
+#include "pawn_structure.h"
+#include "NNUE.h"
 
 typedef int32_t EvalScore_t;
 typedef int32_t Centipawns_t;
 enum {
   EVAL_MAX = 100000,
-  INFINITY = INT32_MAX - 1
+  EVAL_INFINITY = INT32_MAX - 1
 };
 
 enum {
@@ -30,6 +32,29 @@ enum {
 
 Centipawns_t ValueOfPiece(Piece_t piece);
 
-EvalScore_t ScoreOfPosition(BoardInfo_t* boardInfo);
+PackedScore_t PackScore(Centipawns_t mgScore, Centipawns_t egScore);
+
+// keep the material and PST accumulators in the board info in sync as pieces come and go
+void AddPieceToScore(BoardInfo_t* boardInfo, Piece_t piece, Color_t color, Square_t square);
+
+void RemovePieceFromScore(BoardInfo_t* boardInfo, Piece_t piece, Color_t color, Square_t square);
+
+void MovePieceInScore(BoardInfo_t* boardInfo, Piece_t piece, Color_t color, Square_t fromSquare, Square_t toSquare);
+
+// recomputes the accumulators from scratch, for freshly set up positions
+void InitMaterialAndPST(BoardInfo_t* boardInfo);
+
+// the caches each search thread keeps for its own evaluations
+typedef struct {
+    PawnTable_t pawnTable;
+    AccumulatorStack_t accumulatorStack;
+} EvaluationInfo_t;
+
+void ClearEvaluationInfo(EvaluationInfo_t* evalInfo);
+
+// switches between NNUE and the hand crafted eval, only while nothing is searching
+void UseNNUE(bool enabled);
+
+EvalScore_t ScoreOfPosition(BoardInfo_t* boardInfo, GameStack_t* gameStack, EvaluationInfo_t* evalInfo);
 
 #endif
\ No newline at end of file
@@ -1,35 +1,227 @@
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "move_ordering.h"
 #include "evaluation.h"
+#include "SEE.h"
 
-static EvalScore_t MVVScore(BoardInfo_t* boardInfo, Move_t capture) {
+enum {
+    // killers and then the countermove always go ahead of any history score
+    quiet_history_max = (1 + continuation_plies) * history_max,
+    first_killer_score = quiet_history_max + 3,
+    second_killer_score = quiet_history_max + 2,
+    counter_move_score = quiet_history_max + 1
+};
+
+static MoveScore_t MVVScore(BoardInfo_t* boardInfo, Move_t capture) {
     Square_t toSquare = ReadToSquare(capture);
     Square_t fromSquare = ReadFromSquare(capture);
 
     Piece_t victim = PieceOnSquare(boardInfo, toSquare);
     Piece_t attacker = PieceOnSquare(boardInfo, fromSquare);
+    SpecialFlag_t flag = ReadSpecialFlag(capture);
     
-    assert(victim != none_type || ReadSpecialFlag(capture) == en_passant_flag);
+    assert(victim != none_type || flag == en_passant_flag || flag == promotion_flag);
+
+    // a queen promotion is worth about as much as winning a queen, whether it takes something or not
+    MoveScore_t score = ValueOfPiece(victim) - ValueOfPiece(attacker);
+    if(flag == promotion_flag) {
+        score += ValueOfPiece(ReadPromotionPiece(capture));
+    }
+
+    return score;
+}
+
+// the entry for the move played pliesBack plies before the current node, if there was a real one
+static SearchStackEntry_t* PreviousMove(SearchStackEntry_t* searchStack, Ply_t ply, int pliesBack) {
+    if(ply < pliesBack || searchStack[ply - pliesBack].movedPiece == none_type) {
+        return NULL;
+    }
 
-    return ValueOfPiece(victim) - ValueOfPiece(attacker);
+    return &searchStack[ply - pliesBack];
 }
 
-static void InsertionSortCaptures(MoveList_t* moveList, BoardInfo_t* boardInfo) {
-    int maxIndex = moveList->maxCapturesIndex;
-    for(int i = 1; i <= maxIndex; i++) {
-        Move_t capture = moveList->moves[i];
-        EvalScore_t captureScore = MVVScore(boardInfo, capture);
+static PieceToHistory_t* ContinuationTable(
+    MoveOrderingInfo_t* orderingInfo,
+    Color_t color,
+    SearchStackEntry_t* searchStack,
+    Ply_t ply,
+    int pliesBack
+)
+{
+    SearchStackEntry_t* previous = PreviousMove(searchStack, ply, pliesBack);
+    if(previous == NULL) {
+        return NULL;
+    }
 
-        int j = i - 1;
-        while (j >= 0 && (captureScore > MVVScore(boardInfo, moveList->moves[j]))) {
-            moveList->moves[j+1] = moveList->moves[j]; // shift to the right
-            j--;
+    return &orderingInfo->continuationHistory[pliesBack - 1][color][previous->movedPiece][previous->toSquare];
+}
+
+static HistoryScore_t QuietScore(
+    MoveOrderingInfo_t* orderingInfo,
+    BoardInfo_t* boardInfo,
+    SearchStackEntry_t* searchStack,
+    Move_t counterMove,
+    Move_t move,
+    Ply_t ply
+)
+{
+    if(SameMove(move, orderingInfo->killers[ply][0])) {
+        return first_killer_score;
+    } else if(SameMove(move, orderingInfo->killers[ply][1])) {
+        return second_killer_score;
+    } else if(SameMove(move, counterMove)) {
+        return counter_move_score;
+    }
+
+    return ReadQuietHistory(orderingInfo, boardInfo, searchStack, ply, move);
+}
+
+void InitMoveOrderingInfo(MoveOrderingInfo_t* orderingInfo) {
+    for(int ply = 0; ply < PLY_MAX; ply++) {
+        for(int i = 0; i < killers_per_ply; i++) {
+            InitMove(&orderingInfo->killers[ply][i]);
         }
-        moveList->moves[j+1] = capture;
     }
+
+    memset(orderingInfo->history, 0, sizeof(orderingInfo->history));
+    memset(orderingInfo->counterMoves, 0, sizeof(orderingInfo->counterMoves));
+    memset(orderingInfo->continuationHistory, 0, sizeof(orderingInfo->continuationHistory));
+}
+
+void AddKillerMove(MoveOrderingInfo_t* orderingInfo, Move_t move, Ply_t ply) {
+    Move_t* killers = orderingInfo->killers[ply];
+    if(SameMove(move, killers[0])) {
+        return;
+    }
+
+    killers[1] = killers[0];
+    killers[0] = move;
+}
+
+// History gravity: the closer an entry already is to the limit in the bonus' direction, the less it moves,
+// so scores stay within [-history_max, history_max] and old information fades instead of saturating.
+static void ApplyHistoryBonus(HistoryScore_t* entry, HistoryScore_t bonus) {
+    assert(abs(bonus) <= history_max);
+    *entry += bonus - *entry * abs(bonus) / history_max;
+}
+
+void UpdateHistory(MoveOrderingInfo_t* orderingInfo, Color_t color, Move_t move, HistoryScore_t bonus) {
+    ApplyHistoryBonus(&orderingInfo->history[color][ReadFromSquare(move)][ReadToSquare(move)], bonus);
+}
+
+HistoryScore_t ReadHistory(MoveOrderingInfo_t* orderingInfo, Color_t color, Move_t move) {
+    return orderingInfo->history[color][ReadFromSquare(move)][ReadToSquare(move)];
+}
+
+void SetCounterMove(MoveOrderingInfo_t* orderingInfo, Color_t color, SearchStackEntry_t* searchStack, Ply_t ply, Move_t move) {
+    SearchStackEntry_t* previous = PreviousMove(searchStack, ply, 1);
+    if(previous != NULL) {
+        orderingInfo->counterMoves[color][previous->movedPiece][previous->toSquare] = move;
+    }
+}
+
+Move_t ReadCounterMove(MoveOrderingInfo_t* orderingInfo, Color_t color, SearchStackEntry_t* searchStack, Ply_t ply) {
+    SearchStackEntry_t* previous = PreviousMove(searchStack, ply, 1);
+    if(previous == NULL) {
+        Move_t noMove;
+        InitMove(&noMove);
+        return noMove;
+    }
+
+    return orderingInfo->counterMoves[color][previous->movedPiece][previous->toSquare];
+}
+
+HistoryScore_t ReadQuietHistory(
+    MoveOrderingInfo_t* orderingInfo,
+    BoardInfo_t* boardInfo,
+    SearchStackEntry_t* searchStack,
+    Ply_t ply,
+    Move_t move
+)
+{
+    Color_t color = boardInfo->colorToMove;
+    Piece_t piece = PieceOnSquare(boardInfo, ReadFromSquare(move));
+    Square_t toSquare = ReadToSquare(move);
+
+    HistoryScore_t score = ReadHistory(orderingInfo, color, move);
+    for(int pliesBack = 1; pliesBack <= continuation_plies; pliesBack++) {
+        PieceToHistory_t* continuation = ContinuationTable(orderingInfo, color, searchStack, ply, pliesBack);
+        if(continuation != NULL) {
+            score += (*continuation)[piece][toSquare];
+        }
+    }
+
+    return score;
+}
+
+void UpdateQuietHistory(
+    MoveOrderingInfo_t* orderingInfo,
+    BoardInfo_t* boardInfo,
+    SearchStackEntry_t* searchStack,
+    Ply_t ply,
+    Move_t move,
+    HistoryScore_t bonus
+)
+{
+    Color_t color = boardInfo->colorToMove;
+    Piece_t piece = PieceOnSquare(boardInfo, ReadFromSquare(move));
+    Square_t toSquare = ReadToSquare(move);
+
+    UpdateHistory(orderingInfo, color, move, bonus);
+    for(int pliesBack = 1; pliesBack <= continuation_plies; pliesBack++) {
+        PieceToHistory_t* continuation = ContinuationTable(orderingInfo, color, searchStack, ply, pliesBack);
+        if(continuation != NULL) {
+            ApplyHistoryBonus(&(*continuation)[piece][toSquare], bonus);
+        }
+    }
+}
+
+void ScoreCaptures(MoveList_t* moveList, BoardInfo_t* boardInfo) {
+    for(int i = 0; i <= moveList->maxCapturesIndex; i++) {
+        moveList->scores[i] = MVVScore(boardInfo, moveList->moves[i]);
+    }
+}
+
+void ScoreQuiets(
+    MoveList_t* moveList,
+    BoardInfo_t* boardInfo,
+    MoveOrderingInfo_t* orderingInfo,
+    SearchStackEntry_t* searchStack,
+    Ply_t ply
+)
+{
+    Move_t counterMove = ReadCounterMove(orderingInfo, boardInfo->colorToMove, searchStack, ply);
+    for(int i = moveList->maxCapturesIndex + 1; i <= moveList->maxIndex; i++) {
+        moveList->scores[i] = QuietScore(orderingInfo, boardInfo, searchStack, counterMove, moveList->moves[i], ply);
+    }
+}
+
+// Swaps the best scored move left in [index, lastIndex] into index. Most nodes cut off after the first
+// few moves, so one pass per move beats sorting moves that never get searched.
+Move_t PickNextMove(MoveList_t* moveList, int index, int lastIndex) {
+    assert(index <= lastIndex);
+
+    int bestIndex = index;
+    for(int i = index + 1; i <= lastIndex; i++) {
+        if(moveList->scores[i] > moveList->scores[bestIndex]) {
+            bestIndex = i;
+        }
+    }
+
+    Move_t best = moveList->moves[bestIndex];
+    MoveScore_t bestScore = moveList->scores[bestIndex];
+
+    moveList->moves[bestIndex] = moveList->moves[index];
+    moveList->scores[bestIndex] = moveList->scores[index];
+    moveList->moves[index] = best;
+    moveList->scores[index] = bestScore;
+
+    return best;
 }
 
-void SortMoveList(MoveList_t* moveList, BoardInfo_t* boardInfo) {
-    InsertionSortCaptures(moveList, boardInfo);
+// a capture is good if it doesn't lose material once the exchange on the target square plays out
+bool IsGoodCapture(BoardInfo_t* boardInfo, Move_t capture) {
+    return SEEPassesThreshold(boardInfo, capture, 0);
 }
\ No newline at end of file
@@ -1,10 +1,87 @@
 #ifndef __MOVE_ORDERING_H__
 #define __MOVE_ORDERING_H__
 
+#include <stdint.h>
+
 #include "movegen.h"
 #include "board_info.h"
 #include "board_constants.h"
+#include "chess_search.h"
+#include "PV_table.h"
+
+enum {
+    killers_per_ply = 2,
+    continuation_plies = 2, // how far back the continuation histories look
+    history_max = 16384
+};
+
+typedef int32_t HistoryScore_t;
+
+// the move played at each ply of the line being searched, so ordering can see what led to the current node
+typedef struct {
+    Piece_t movedPiece; // none_type for a null move
+    Square_t toSquare;
+} SearchStackEntry_t;
+
+typedef HistoryScore_t PieceToHistory_t[NUM_PIECES][NUM_SQUARES];
+
+// quiet move ordering information, every search thread owns one
+typedef struct {
+    Move_t killers[PLY_MAX][killers_per_ply];
+    HistoryScore_t history[2][NUM_SQUARES][NUM_SQUARES]; // [color][from][to]
+
+    // the reply that last refuted the opponent's previous move, [color][prevPiece][prevTo]
+    Move_t counterMoves[2][NUM_PIECES][NUM_SQUARES];
+
+    // how well a quiet did after the move one or two plies earlier, [plies back - 1][color][prevPiece][prevTo][piece][to]
+    PieceToHistory_t continuationHistory[continuation_plies][2][NUM_PIECES][NUM_SQUARES];
+} MoveOrderingInfo_t;
+
+void InitMoveOrderingInfo(MoveOrderingInfo_t* orderingInfo);
+
+void AddKillerMove(MoveOrderingInfo_t* orderingInfo, Move_t move, Ply_t ply);
+
+void UpdateHistory(MoveOrderingInfo_t* orderingInfo, Color_t color, Move_t move, HistoryScore_t bonus);
+
+HistoryScore_t ReadHistory(MoveOrderingInfo_t* orderingInfo, Color_t color, Move_t move);
+
+void SetCounterMove(MoveOrderingInfo_t* orderingInfo, Color_t color, SearchStackEntry_t* searchStack, Ply_t ply, Move_t move);
+
+// no move if the previous ply was the root or a null move
+Move_t ReadCounterMove(MoveOrderingInfo_t* orderingInfo, Color_t color, SearchStackEntry_t* searchStack, Ply_t ply);
+
+// the butterfly history plus both continuation histories, for a quiet move that hasn't been made yet
+HistoryScore_t ReadQuietHistory(
+    MoveOrderingInfo_t* orderingInfo,
+    BoardInfo_t* boardInfo,
+    SearchStackEntry_t* searchStack,
+    Ply_t ply,
+    Move_t move
+);
+
+void UpdateQuietHistory(
+    MoveOrderingInfo_t* orderingInfo,
+    BoardInfo_t* boardInfo,
+    SearchStackEntry_t* searchStack,
+    Ply_t ply,
+    Move_t move,
+    HistoryScore_t bonus
+);
+
+// the scores PickNextMove goes by, MVV-LVA for the captures and killers, countermove then history for the quiets
+void ScoreCaptures(MoveList_t* moveList, BoardInfo_t* boardInfo);
+
+void ScoreQuiets(
+    MoveList_t* moveList,
+    BoardInfo_t* boardInfo,
+    MoveOrderingInfo_t* orderingInfo,
+    SearchStackEntry_t* searchStack,
+    Ply_t ply
+);
+
+// the best move left from index on, moved to index so the next call starts after it
+Move_t PickNextMove(MoveList_t* moveList, int index, int lastIndex);
 
-void SortMoveList(MoveList_t* moveList, BoardInfo_t* boardInfo);
+bool IsGoodCapture(BoardInfo_t* boardInfo, Move_t capture);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,250 @@
+#include <assert.h>
+
+#include "move_picker.h"
+
+enum {
+    pick_tt_move,
+    generate_captures,
+    pick_good_captures,
+    pick_killers,
+    generate_quiets,
+    pick_quiets,
+    pick_bad_captures,
+
+    generate_qsearch_moves,
+    pick_qsearch_moves,
+    generate_quiet_checks,
+    pick_quiet_checks,
+
+    picking_done
+};
+
+static void InitPickerCommon(MovePicker_t* picker, BoardInfo_t* boardInfo, GameStack_t* gameStack) {
+    picker->boardInfo = boardInfo;
+    picker->gameStack = gameStack;
+    picker->orderingInfo = NULL;
+    picker->searchStack = NULL;
+    picker->ply = 0;
+
+    DefineMovegenInfo(&picker->movegenInfo, boardInfo);
+    picker->moveList.maxIndex = movelist_empty;
+    picker->moveList.maxCapturesIndex = movelist_empty;
+
+    picker->index = 0;
+    picker->skipQuiets = false;
+    picker->evasionsGenerated = false;
+    picker->includeQuietChecks = false;
+    InitMove(&picker->ttMove);
+    picker->numBadCaptures = 0;
+}
+
+void InitMovePicker(
+    MovePicker_t* picker,
+    BoardInfo_t* boardInfo,
+    GameStack_t* gameStack,
+    MoveOrderingInfo_t* orderingInfo,
+    SearchStackEntry_t* searchStack,
+    Move_t ttMove,
+    Ply_t ply
+)
+{
+    InitPickerCommon(picker, boardInfo, gameStack);
+    picker->orderingInfo = orderingInfo;
+    picker->searchStack = searchStack;
+    picker->ply = ply;
+    picker->ttMove = ttMove;
+    picker->stage = pick_tt_move;
+}
+
+void InitCapturePicker(MovePicker_t* picker, BoardInfo_t* boardInfo, GameStack_t* gameStack, bool includeQuietChecks) {
+    InitPickerCommon(picker, boardInfo, gameStack);
+    picker->includeQuietChecks = includeQuietChecks;
+    picker->stage = generate_qsearch_moves;
+}
+
+void SkipQuietMoves(MovePicker_t* picker) {
+    picker->skipQuiets = true;
+}
+
+int CountEvasions(MovePicker_t* picker) {
+    assert(picker->movegenInfo.inCheck);
+    assert(picker->stage == pick_tt_move && !picker->evasionsGenerated);
+
+    GenerateEvasions(&picker->moveList, picker->boardInfo, picker->gameStack, &picker->movegenInfo);
+    picker->evasionsGenerated = true;
+
+    return picker->moveList.maxIndex + 1;
+}
+
+static bool IsTTMove(MovePicker_t* picker, Move_t move) {
+    return SameMove(move, picker->ttMove);
+}
+
+static bool IsKiller(MovePicker_t* picker, Move_t move) {
+    Move_t* killers = picker->orderingInfo->killers[picker->ply];
+    for(int i = 0; i < killers_per_ply; i++) {
+        if(SameMove(move, killers[i])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// killers come from sibling positions, so they might be captures or not even legal here
+static bool KillerIsPlayable(MovePicker_t* picker, Move_t killer) {
+    BoardInfo_t* boardInfo = picker->boardInfo;
+    SpecialFlag_t flag = ReadSpecialFlag(killer);
+
+    bool isQuiet =
+        PieceOnSquare(boardInfo, ReadToSquare(killer)) == none_type &&
+        flag != en_passant_flag &&
+        flag != promotion_flag;
+
+    return
+        killer.data != 0 &&
+        isQuiet &&
+        !IsTTMove(picker, killer) &&
+        MoveIsLegal(boardInfo, picker->gameStack, &picker->movegenInfo, killer);
+}
+
+static void GenerateScoredCaptures(MovePicker_t* picker) {
+    // evasions are captures first, so CountEvasions already left them where GenerateCaptures would have
+    if(!picker->evasionsGenerated) {
+        GenerateCaptures(&picker->moveList, picker->boardInfo, picker->gameStack, &picker->movegenInfo);
+    }
+
+    ScoreCaptures(&picker->moveList, picker->boardInfo);
+    picker->index = 0;
+}
+
+bool NextMove(MovePicker_t* picker, Move_t* move) {
+    MoveList_t* moveList = &picker->moveList;
+
+    switch(picker->stage) {
+        case pick_tt_move:
+            picker->stage = generate_captures;
+            if(picker->ttMove.data != 0 && MoveIsLegal(picker->boardInfo, picker->gameStack, &picker->movegenInfo, picker->ttMove)) {
+                *move = picker->ttMove;
+                return true;
+            }
+            // fall through
+        case generate_captures:
+            GenerateScoredCaptures(picker);
+            picker->stage = pick_good_captures;
+            // fall through
+        case pick_good_captures:
+            while(picker->index <= moveList->maxCapturesIndex) {
+                Move_t capture = PickNextMove(moveList, picker->index++, moveList->maxCapturesIndex);
+                if(IsTTMove(picker, capture)) {
+                    continue;
+                }
+
+                if(!IsGoodCapture(picker->boardInfo, capture)) {
+                    picker->badCaptures[picker->numBadCaptures++] = capture;
+                    continue;
+                }
+
+                *move = capture;
+                return true;
+            }
+
+            picker->index = 0;
+            picker->stage = pick_killers;
+            // fall through
+        case pick_killers:
+            while(!picker->skipQuiets && picker->index < killers_per_ply) {
+                Move_t killer = picker->orderingInfo->killers[picker->ply][picker->index++];
+                if(KillerIsPlayable(picker, killer)) {
+                    *move = killer;
+                    return true;
+                }
+            }
+
+            picker->stage = generate_quiets;
+            // fall through
+        case generate_quiets:
+            if(!picker->skipQuiets) {
+                if(!picker->evasionsGenerated) {
+                    GenerateQuiets(moveList, picker->boardInfo, picker->gameStack, &picker->movegenInfo);
+                }
+                ScoreQuiets(moveList, picker->boardInfo, picker->orderingInfo, picker->searchStack, picker->ply);
+            }
+
+            picker->index = moveList->maxCapturesIndex + 1;
+            picker->stage = pick_quiets;
+            // fall through
+        case pick_quiets:
+            while(!picker->skipQuiets && picker->index <= moveList->maxIndex) {
+                Move_t quiet = PickNextMove(moveList, picker->index++, moveList->maxIndex);
+                if(IsTTMove(picker, quiet) || IsKiller(picker, quiet)) {
+                    continue;
+                }
+
+                *move = quiet;
+                return true;
+            }
+
+            picker->index = 0;
+            picker->stage = pick_bad_captures;
+            // fall through
+        case pick_bad_captures:
+            if(picker->index < picker->numBadCaptures) {
+                *move = picker->badCaptures[picker->index++];
+                return true;
+            }
+
+            picker->stage = picking_done;
+            return false;
+
+        case generate_qsearch_moves:
+            if(picker->movegenInfo.inCheck) {
+                GenerateEvasions(moveList, picker->boardInfo, picker->gameStack, &picker->movegenInfo);
+                ScoreCaptures(moveList, picker->boardInfo);
+                picker->index = 0;
+            } else {
+                GenerateScoredCaptures(picker);
+            }
+
+            picker->stage = pick_qsearch_moves;
+            // fall through
+        case pick_qsearch_moves:
+            if(picker->index <= moveList->maxCapturesIndex) {
+                *move = PickNextMove(moveList, picker->index++, moveList->maxCapturesIndex);
+                return true;
+            }
+
+            // quiet evasions go in the order they were generated
+            if(picker->index <= moveList->maxIndex) {
+                *move = moveList->moves[picker->index++];
+                return true;
+            }
+
+            // evasions already have every move that answers the check
+            if(!picker->includeQuietChecks || picker->movegenInfo.inCheck) {
+                picker->stage = picking_done;
+                return false;
+            }
+
+            picker->stage = generate_quiet_checks;
+            // fall through
+        case generate_quiet_checks:
+            GenerateQuietChecks(moveList, picker->boardInfo, picker->gameStack, &picker->movegenInfo);
+            picker->stage = pick_quiet_checks;
+            // fall through
+        case pick_quiet_checks:
+            if(picker->index <= moveList->maxIndex) {
+                *move = moveList->moves[picker->index++];
+                return true;
+            }
+
+            picker->stage = picking_done;
+            return false;
+
+        case picking_done:
+            return false;
+    }
+
+    assert(false);
+    return false;
+}
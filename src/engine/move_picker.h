@@ -0,0 +1,61 @@
+#ifndef __MOVE_PICKER_H__
+#define __MOVE_PICKER_H__
+
+#include <stdbool.h>
+
+#include "movegen.h"
+#include "board_info.h"
+#include "game_state.h"
+#include "chess_search.h"
+#include "move_ordering.h"
+
+typedef uint8_t PickerStage_t;
+
+// Hands out moves one at a time, only generating the next group once the previous one is used up.
+// Most nodes cut off on the hash move or a capture, and never pay for generating the quiets.
+typedef struct {
+    BoardInfo_t* boardInfo;
+    GameStack_t* gameStack;
+    MoveOrderingInfo_t* orderingInfo;
+    SearchStackEntry_t* searchStack;
+    Ply_t ply;
+
+    MovegenInfo_t movegenInfo;
+    MoveList_t moveList;
+
+    PickerStage_t stage;
+    int index;
+    bool skipQuiets;
+    bool evasionsGenerated;
+    bool includeQuietChecks;
+    Move_t ttMove;
+
+    Move_t badCaptures[MOVELIST_MAX];
+    int numBadCaptures;
+} MovePicker_t;
+
+// hash move, good captures, killers, quiets, bad captures
+void InitMovePicker(
+    MovePicker_t* picker,
+    BoardInfo_t* boardInfo,
+    GameStack_t* gameStack,
+    MoveOrderingInfo_t* orderingInfo,
+    SearchStackEntry_t* searchStack,
+    Move_t ttMove,
+    Ply_t ply
+);
+
+// captures and queen promotions for the quiescence search, followed by the quiet checks if asked for.
+// Every evasion when in check
+void InitCapturePicker(MovePicker_t* picker, BoardInfo_t* boardInfo, GameStack_t* gameStack, bool includeQuietChecks);
+
+bool NextMove(MovePicker_t* picker, Move_t* move);
+
+// killers and quiets that haven't been handed out yet are never generated or returned
+void SkipQuietMoves(MovePicker_t* picker);
+
+// Generates every evasion up front and counts them, before the first NextMove. The stages then hand out
+// that same list instead of generating the captures and quiets again.
+int CountEvasions(MovePicker_t* picker);
+
+#endif
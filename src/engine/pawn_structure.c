@@ -0,0 +1,119 @@
+#include "pawn_structure.h"
+#include "evaluation.h"
+#include "lookup.h"
+#include "bitboards.h"
+#include "PST.h"
+
+enum {
+    pawn_table_mask = pawn_table_entries - 1,
+    no_king_square = NUM_SQUARES,
+
+    isolated_pawn_mg = -10,
+    isolated_pawn_eg = -15,
+    doubled_pawn_mg = -10,
+    doubled_pawn_eg = -20,
+    backward_pawn_mg = -8,
+    backward_pawn_eg = -10,
+    pawn_shield_mg = 12
+};
+
+// indexed by [phase][rank], ranks counted from the pawn's own side
+static Centipawns_t passedPawnBonus[NUM_PHASES][8] = {
+    { 0, 5, 10, 15, 25, 40, 60, 0 },
+    { 0, 10, 15, 25, 40, 65, 100, 0 }
+};
+
+static Square_t StopSquare(Square_t square, Color_t color) {
+    return (color == white) ? square + 8 : square - 8;
+}
+
+static int RelativeRank(Square_t square, Color_t color) {
+    return (color == white) ? square / 8 : 7 - (square / 8);
+}
+
+// no friendly pawn level with or behind it on the adjacent files, and it can't step up without being taken
+static bool PawnIsBackward(Square_t square, Color_t color, Bitboard_t ownPawns, Bitboard_t enemyPawns) {
+    Bitboard_t supporters = GetAdjacentFileMask(square) & ownPawns & ~GetPassedPawnMask(square, color);
+    Bitboard_t stopAttackers = GetPawnCheckmask(StopSquare(square, color), color) & enemyPawns;
+
+    return !supporters && stopAttackers;
+}
+
+static PackedScore_t PawnTerms(BoardInfo_t* boardInfo, Color_t color) {
+    Bitboard_t ownPawns = boardInfo->pawns[color];
+    Bitboard_t enemyPawns = boardInfo->pawns[!color];
+    Centipawns_t mgScore = 0;
+    Centipawns_t egScore = 0;
+
+    Bitboard_t pawns = ownPawns;
+    while(pawns) {
+        Square_t square = LSB(pawns);
+        Bitboard_t adjacentFiles = GetAdjacentFileMask(square);
+        Bitboard_t frontSpan = GetPassedPawnMask(square, color) & ~adjacentFiles;
+
+        if(frontSpan & ownPawns) {
+            mgScore += doubled_pawn_mg;
+            egScore += doubled_pawn_eg;
+        } else if(!(GetPassedPawnMask(square, color) & enemyPawns)) {
+            int rank = RelativeRank(square, color);
+            mgScore += passedPawnBonus[mg_phase][rank];
+            egScore += passedPawnBonus[eg_phase][rank];
+        }
+
+        if(!(adjacentFiles & ownPawns)) {
+            mgScore += isolated_pawn_mg;
+            egScore += isolated_pawn_eg;
+        } else if(PawnIsBackward(square, color, ownPawns, enemyPawns)) {
+            mgScore += backward_pawn_mg;
+            egScore += backward_pawn_eg;
+        }
+
+        ResetLSB(&pawns);
+    }
+
+    return PackScore(mgScore, egScore);
+}
+
+// own pawns on the king's file and the files next to it, one or two ranks in front of the king
+static PackedScore_t PawnShield(BoardInfo_t* boardInfo, Color_t color, Square_t kingSquare) {
+    Bitboard_t kingZone = GetKingAttackSet(kingSquare) | GetSingleBitset(kingSquare);
+    Bitboard_t shieldSquares = (color == white) ? NortOne(kingZone) : SoutOne(kingZone);
+    shieldSquares &= GetPassedPawnMask(kingSquare, color);
+
+    return PackScore(PopCount(boardInfo->pawns[color] & shieldSquares) * pawn_shield_mg, 0);
+}
+
+static void UpdateShield(PawnTableEntry_t* entry, BoardInfo_t* boardInfo, Color_t color) {
+    Square_t kingSquare = KingSquare(boardInfo, color);
+    if(entry->shieldKingSquares[color] != kingSquare) {
+        entry->shieldKingSquares[color] = kingSquare;
+        entry->shieldScores[color] = PawnShield(boardInfo, color, kingSquare);
+    }
+}
+
+void ClearPawnTable(PawnTable_t* pawnTable) {
+    for(int i = 0; i < pawn_table_entries; i++) {
+        PawnTableEntry_t* entry = &pawnTable->entries[i];
+        entry->key = 0;
+        entry->score = 0;
+        entry->shieldScores[white] = 0;
+        entry->shieldScores[black] = 0;
+        entry->shieldKingSquares[white] = no_king_square;
+        entry->shieldKingSquares[black] = no_king_square;
+    }
+}
+
+PackedScore_t PawnStructureScore(PawnTable_t* pawnTable, BoardInfo_t* boardInfo, ZobristHash_t pawnHash) {
+    PawnTableEntry_t* entry = &pawnTable->entries[pawnHash & pawn_table_mask];
+    if(entry->key != pawnHash) {
+        entry->key = pawnHash;
+        entry->score = PawnTerms(boardInfo, white) - PawnTerms(boardInfo, black);
+        entry->shieldKingSquares[white] = no_king_square;
+        entry->shieldKingSquares[black] = no_king_square;
+    }
+
+    UpdateShield(entry, boardInfo, white);
+    UpdateShield(entry, boardInfo, black);
+
+    return entry->score + entry->shieldScores[white] - entry->shieldScores[black];
+}
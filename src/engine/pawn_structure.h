@@ -0,0 +1,33 @@
+#ifndef __PAWN_STRUCTURE_H__
+#define __PAWN_STRUCTURE_H__
+
+#include <stdint.h>
+
+#include "board_constants.h"
+#include "board_info.h"
+#include "game_state.h"
+
+enum {
+    pawn_table_entries = 1 << 13
+};
+
+// pawn structure barely changes during a search, so its terms are cached by the pawn-only hash.
+// the shield depends on where the kings are too, so it's recomputed only when a king has moved
+typedef struct {
+    ZobristHash_t key;
+    PackedScore_t score; // passed, isolated, doubled and backward pawns
+    PackedScore_t shieldScores[2];
+    Square_t shieldKingSquares[2];
+} PawnTableEntry_t;
+
+// every search thread owns one
+typedef struct {
+    PawnTableEntry_t entries[pawn_table_entries];
+} PawnTable_t;
+
+void ClearPawnTable(PawnTable_t* pawnTable);
+
+// from white's point of view, packed as midgame and endgame halves
+PackedScore_t PawnStructureScore(PawnTable_t* pawnTable, BoardInfo_t* boardInfo, ZobristHash_t pawnHash);
+
+#endif
@@ -0,0 +1,215 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdatomic.h>
+
+#include "transposition_table.h"
+
+enum {
+    bucket_size = 4,
+    bytes_per_mb = 1024 * 1024,
+
+    bound_bitmask = 0b11,
+    age_offset = 2,
+    age_cycle = 64, // 6 bits of age
+
+    score_offset = 16,
+    depth_offset = 48,
+    bound_and_age_offset = 56,
+
+    age_penalty = 4,
+    hashfull_sample = 1000
+};
+
+typedef uint8_t TTAge_t;
+typedef uint64_t TTData_t;
+
+// Slots are shared between search threads without locks. The key is stored xor'd with the data,
+// so a slot torn by two threads writing at once just fails the key check instead of returning garbage.
+// 16 bytes per slot, so a bucket fits exactly in a 64 byte cache line
+typedef struct {
+    _Atomic ZobristHash_t keyXorData;
+    _Atomic TTData_t data;
+} TTSlot_t;
+
+typedef struct {
+    TTSlot_t slots[bucket_size];
+} TTBucket_t;
+
+typedef struct {
+    TTBucket_t* buckets;
+    uint64_t numBuckets;
+    TTAge_t age;
+} TranspositionTable_t;
+
+// unpacked copy of a slot, only ever lives on a single thread's stack
+typedef struct {
+    ZobristHash_t key;
+    EvalScore_t score;
+    Move_t bestMove;
+    Depth_t depth;
+    Bound_t bound;
+    TTAge_t age;
+} TTSlotContents_t;
+
+static TranspositionTable_t tt = { NULL, 0, 0 };
+
+static TTData_t PackData(TTSlotContents_t* contents) {
+    uint8_t boundAndAge = (contents->age << age_offset) | contents->bound;
+    return
+        (TTData_t)contents->bestMove.data |
+        ((TTData_t)(uint32_t)contents->score << score_offset) |
+        ((TTData_t)contents->depth << depth_offset) |
+        ((TTData_t)boundAndAge << bound_and_age_offset);
+}
+
+static TTSlotContents_t ReadSlot(TTSlot_t* slot) {
+    TTData_t data = atomic_load_explicit(&slot->data, memory_order_relaxed);
+    ZobristHash_t keyXorData = atomic_load_explicit(&slot->keyXorData, memory_order_relaxed);
+    uint8_t boundAndAge = data >> bound_and_age_offset;
+
+    TTSlotContents_t contents;
+    contents.key = keyXorData ^ data;
+    contents.bestMove.data = (uint16_t)data;
+    contents.score = (int32_t)(uint32_t)(data >> score_offset);
+    contents.depth = (Depth_t)(data >> depth_offset);
+    contents.bound = boundAndAge & bound_bitmask;
+    contents.age = boundAndAge >> age_offset;
+    return contents;
+}
+
+static void WriteSlot(TTSlot_t* slot, TTSlotContents_t* contents) {
+    TTData_t data = PackData(contents);
+    atomic_store_explicit(&slot->keyXorData, contents->key ^ data, memory_order_relaxed);
+    atomic_store_explicit(&slot->data, data, memory_order_relaxed);
+}
+
+static int AgeDistance(TTSlotContents_t* contents) {
+    return (age_cycle + tt.age - contents->age) % age_cycle;
+}
+
+static TTBucket_t* GetBucket(ZobristHash_t hash) {
+    // maps the hash uniformly onto [0, numBuckets) without needing a power of two size
+    uint64_t index = ((unsigned __int128)hash * tt.numBuckets) >> 64;
+    return &tt.buckets[index];
+}
+
+void TTInit() {
+    TTResize(hash_default_mb);
+}
+
+void TTResize(Megabytes_t megabytes) {
+    free(tt.buckets);
+
+    tt.numBuckets = ((uint64_t)megabytes * bytes_per_mb) / sizeof(TTBucket_t);
+    tt.buckets = calloc(tt.numBuckets, sizeof(TTBucket_t));
+
+    if(tt.buckets == NULL) {
+        printf("info string failed to allocate %u MB hash, falling back to %d MB\n", megabytes, hash_min_mb);
+        tt.numBuckets = ((uint64_t)hash_min_mb * bytes_per_mb) / sizeof(TTBucket_t);
+        tt.buckets = calloc(tt.numBuckets, sizeof(TTBucket_t));
+    }
+
+    assert(tt.buckets != NULL);
+    tt.age = 0;
+}
+
+void TTClear() {
+    memset(tt.buckets, 0, tt.numBuckets * sizeof(TTBucket_t));
+    tt.age = 0;
+}
+
+void TTNewSearch() {
+    tt.age = (tt.age + 1) % age_cycle;
+}
+
+bool TTProbe(ZobristHash_t hash, TTEntry_t* entry) {
+    TTBucket_t* bucket = GetBucket(hash);
+
+    for(int i = 0; i < bucket_size; i++) {
+        TTSlotContents_t contents = ReadSlot(&bucket->slots[i]);
+        if(contents.key == hash && contents.bound != bound_none) {
+            if(contents.age != tt.age) {
+                contents.age = tt.age; // refresh so it survives replacement
+                WriteSlot(&bucket->slots[i], &contents);
+            }
+
+            entry->score = contents.score;
+            entry->bestMove = contents.bestMove;
+            entry->depth = contents.depth;
+            entry->bound = contents.bound;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static int ReplacementValue(TTSlotContents_t* contents) {
+    return contents->depth - age_penalty * AgeDistance(contents);
+}
+
+static TTSlot_t* ChooseSlotToReplace(TTBucket_t* bucket, ZobristHash_t hash, TTSlotContents_t* replacedContents) {
+    TTSlot_t* replace = &bucket->slots[0];
+    *replacedContents = ReadSlot(replace);
+
+    for(int i = 0; i < bucket_size; i++) {
+        TTSlotContents_t contents = ReadSlot(&bucket->slots[i]);
+        if(contents.key == hash || contents.bound == bound_none) {
+            *replacedContents = contents;
+            return &bucket->slots[i];
+        }
+
+        if(ReplacementValue(&contents) < ReplacementValue(replacedContents)) {
+            replace = &bucket->slots[i];
+            *replacedContents = contents;
+        }
+    }
+
+    return replace;
+}
+
+void TTStore(
+    ZobristHash_t hash,
+    Move_t bestMove,
+    EvalScore_t score,
+    Depth_t depth,
+    Bound_t bound
+)
+{
+    TTSlotContents_t old;
+    TTSlot_t* slot = ChooseSlotToReplace(GetBucket(hash), hash, &old);
+
+    if(old.key == hash) {
+        // don't let a shallow bound from this search clobber deeper information about the same position
+        bool isShallowerBound = bound != exact_bound && depth + 2 < old.depth && AgeDistance(&old) == 0;
+        if(isShallowerBound) {
+            return;
+        }
+
+        // a fail low has no best move, so keep the one we already know about
+        if(bestMove.data == 0) {
+            bestMove = old.bestMove;
+        }
+    }
+
+    TTSlotContents_t contents = { hash, score, bestMove, depth, bound, tt.age };
+    WriteSlot(slot, &contents);
+}
+
+int TTHashfull() {
+    int sampleSize = (tt.numBuckets < hashfull_sample) ? tt.numBuckets : hashfull_sample;
+
+    int used = 0;
+    for(int i = 0; i < sampleSize; i++) {
+        for(int j = 0; j < bucket_size; j++) {
+            TTSlotContents_t contents = ReadSlot(&tt.buckets[i].slots[j]);
+            if(contents.bound != bound_none && AgeDistance(&contents) == 0) {
+                used++;
+            }
+        }
+    }
+
+    return (used * 1000) / (sampleSize * bucket_size);
+}
\ No newline at end of file
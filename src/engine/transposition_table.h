@@ -0,0 +1,55 @@
+#ifndef __TRANSPOSITION_TABLE_H__
+#define __TRANSPOSITION_TABLE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "move.h"
+#include "zobrist.h"
+#include "evaluation.h"
+#include "chess_search.h"
+
+typedef uint32_t Megabytes_t;
+
+enum TranspositionTableOptions {
+    hash_default_mb = 16,
+    hash_min_mb = 1,
+    hash_max_mb = 4096,
+};
+
+typedef uint8_t Bound_t;
+enum {
+    bound_none,
+    lower_bound,
+    upper_bound,
+    exact_bound
+};
+
+typedef struct {
+    EvalScore_t score;
+    Move_t bestMove;
+    Depth_t depth;
+    Bound_t bound;
+} TTEntry_t;
+
+void TTInit();
+
+void TTResize(Megabytes_t megabytes);
+
+void TTClear();
+
+void TTNewSearch();
+
+bool TTProbe(ZobristHash_t hash, TTEntry_t* entry);
+
+void TTStore(
+    ZobristHash_t hash,
+    Move_t bestMove,
+    EvalScore_t score,
+    Depth_t depth,
+    Bound_t bound
+);
+
+int TTHashfull();
+
+#endif
\ No newline at end of file
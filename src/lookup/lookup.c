@@ -1,15 +1,33 @@
 #include <assert.h>
+#include <stdlib.h>
 
 #include "lookup.h"
 #include "bitboards.h"
 
+#ifdef RUNTIME_TABLES
 static Lookup_t lookup;
 
+// only the one for the backend that gets picked is ever filled
+static Bitboard_t magicAttackTable[NUM_HASH_ENTRIES];
+static Bitboard_t pextAttackTable[NUM_HASH_ENTRIES];
+#else
+#include "lookup_tables.h"
 
+static const Lookup_t lookup = LOOKUP_TABLES;
+static const Bitboard_t magicAttackTable[NUM_HASH_ENTRIES] = MAGIC_ATTACK_TABLE;
+static const Bitboard_t pextAttackTable[NUM_HASH_ENTRIES] = PEXT_ATTACK_TABLE;
+#endif
+
+static bool usePext;
+
+// the tables may be built into a copy before the real ones exist, so building them can't go through the getters
+static Bitboard_t SquareToBitset(Square_t square) {
+    return C64(1) << square;
+}
 
 static void InitSingleBitset(Bitboard_t singleBitsets[]) {
     for(Square_t i = 0; i < NUM_SQUARES; i++) {
-        singleBitsets[i] = C64(1) << i;
+        singleBitsets[i] = SquareToBitset(i);
     }
 }
 
@@ -25,7 +43,7 @@ static Bitboard_t SoSoWe(Bitboard_t b) {return (b & not_a_file ) >> 17;}
 
 static void InitKnightAttacks(Bitboard_t knightAttacks[]) {
     for(Square_t i = 0; i < NUM_SQUARES; i++) {
-        Bitboard_t squareBitset = GetSingleBitset(i);
+        Bitboard_t squareBitset = SquareToBitset(i);
         knightAttacks[i] = 
             NoNoEa(squareBitset) |
             NoEaEa(squareBitset) |
@@ -40,7 +58,7 @@ static void InitKnightAttacks(Bitboard_t knightAttacks[]) {
 
 static void InitKingAttacks(Bitboard_t kingAttacks[]) {
     for(Square_t i = 0; i < NUM_SQUARES; i++) {
-        Bitboard_t squareBitset = GetSingleBitset(i);
+        Bitboard_t squareBitset = SquareToBitset(i);
         kingAttacks[i] = 
             NortOne(squareBitset) |
             NoEaOne(squareBitset) |
@@ -74,7 +92,7 @@ static void FillSlidingCheckmask(Bitboard_t* checkmasks, Bitboard_t singleBitset
 
 static void InitPawnCheckmasks(Bitboard_t pawnCheckmasks[][NUM_SQUARES]) {
     for(Square_t i = 0; i < NUM_SQUARES; i++) {
-        Bitboard_t squareBitset = GetSingleBitset(i);
+        Bitboard_t squareBitset = SquareToBitset(i);
         
         pawnCheckmasks[white][i] =
             NoEaOne(squareBitset) |
@@ -90,7 +108,7 @@ static void InitSlidingCheckmasks(Bitboard_t slidingCheckmasks[NUM_SQUARES][NUM_
     InitializeSlidingCheckmasksWithZeros(slidingCheckmasks);
 
     for(Square_t kingSquare = 0; kingSquare < NUM_SQUARES; kingSquare++) {
-        Bitboard_t kingBitboard = GetSingleBitset(kingSquare);
+        Bitboard_t kingBitboard = SquareToBitset(kingSquare);
         
         FillSlidingCheckmask(slidingCheckmasks[kingSquare], kingBitboard, NortOne);
         FillSlidingCheckmask(slidingCheckmasks[kingSquare], kingBitboard, EastOne);
@@ -117,7 +135,7 @@ static Bitboard_t GetSingleDirectionRay(Bitboard_t singleBitset, DirectionCallba
 
 static void InitDirectionalRays(Bitboard_t directionalRays[NUM_SQUARES][NUM_DIRECTIONS]) {
     for(int i = 0; i < NUM_SQUARES; i++) {
-        Bitboard_t singleBitset = GetSingleBitset(i);
+        Bitboard_t singleBitset = SquareToBitset(i);
 
         directionalRays[i][N] = GetSingleDirectionRay(singleBitset, NortOne);
         directionalRays[i][NE] = GetSingleDirectionRay(singleBitset, NoEaOne);
@@ -130,6 +148,23 @@ static void InitDirectionalRays(Bitboard_t directionalRays[NUM_SQUARES][NUM_DIRE
     }
 }
 
+static void InitAdjacentFileMasks(Bitboard_t adjacentFileMasks[NUM_SQUARES]) {
+    for(Square_t i = 0; i < NUM_SQUARES; i++) {
+        Bitboard_t file = (Bitboard_t)a_file << (i % 8);
+        adjacentFileMasks[i] = EastOne(file) | WestOne(file);
+    }
+}
+
+static void InitPassedPawnMasks(Bitboard_t passedPawnMasks[2][NUM_SQUARES], Bitboard_t adjacentFileMasks[NUM_SQUARES]) {
+    for(Square_t i = 0; i < NUM_SQUARES; i++) {
+        Bitboard_t files = ((Bitboard_t)a_file << (i % 8)) | adjacentFileMasks[i];
+        Bitboard_t filesOnSameRank = files & ((Bitboard_t)rank_1 << (8 * (i / 8)));
+
+        passedPawnMasks[white][i] = GetSingleDirectionRay(filesOnSameRank, NortOne);
+        passedPawnMasks[black][i] = GetSingleDirectionRay(filesOnSameRank, SoutOne);
+    }
+}
+
 static void InitCastleSquares(Square_t ksCastleSquares[], Square_t qsCastleSquares[]) {
     ksCastleSquares[white] = LSB(white_kingside_castle_bb);
     ksCastleSquares[black] = LSB(black_kingside_castle_bb);
@@ -138,15 +173,40 @@ static void InitCastleSquares(Square_t ksCastleSquares[], Square_t qsCastleSquar
     qsCastleSquares[black] = LSB(black_queenside_castle_bb);
 }
 
+void BuildLookupTables(Lookup_t* lookup) {
+    // the slider attacks are built separately, the entries are the same whichever backend indexes them
+    Bitboard_t* scratchAttackTable = malloc(NUM_HASH_ENTRIES * sizeof(*scratchAttackTable));
+
+    InitSingleBitset(lookup->singleBitsets);
+    InitKnightAttacks(lookup->knightAttacks);
+    InitKingAttacks(lookup->kingAttacks);
+    InitAllMagicEntries(lookup->rookMagicEntries, lookup->bishopMagicEntries, scratchAttackTable);
+    InitSlidingCheckmasks(lookup->slidingCheckmasks);
+    InitPawnCheckmasks(lookup->pawnCheckmasks);
+    InitDirectionalRays(lookup->directionalRays);
+    InitAdjacentFileMasks(lookup->adjacentFileMasks);
+    InitPassedPawnMasks(lookup->passedPawnMasks, lookup->adjacentFileMasks);
+    InitCastleSquares(lookup->ksCastleSquares, lookup->qsCastleSquares);
+
+    free(scratchAttackTable);
+}
+
+// the backend is picked once at startup, the magics are the fallback for CPUs without a fast PEXT
 void InitLookupTables() {
-    InitSingleBitset(lookup.singleBitsets);
-    InitKnightAttacks(lookup.knightAttacks);
-    InitKingAttacks(lookup.kingAttacks);
-    InitAllMagicEntries(lookup.rookMagicEntries, lookup.bishopMagicEntries, lookup.magicHashTable);
-    InitSlidingCheckmasks(lookup.slidingCheckmasks);
-    InitPawnCheckmasks(lookup.pawnCheckmasks);
-    InitDirectionalRays(lookup.directionalRays);
-    InitCastleSquares(lookup.ksCastleSquares, lookup.qsCastleSquares);
+    usePext = CpuHasFastPext();
+
+#ifdef RUNTIME_TABLES
+    BuildLookupTables(&lookup);
+    if(usePext) {
+        InitAllPextEntries(lookup.rookMagicEntries, lookup.bishopMagicEntries, pextAttackTable);
+    } else {
+        InitAllMagicEntries(lookup.rookMagicEntries, lookup.bishopMagicEntries, magicAttackTable);
+    }
+#endif
+}
+
+const Lookup_t* ReadLookupTables() {
+    return &lookup;
 }
 
 Bitboard_t GetSingleBitset(Square_t square) {
@@ -162,20 +222,28 @@ Bitboard_t GetKingAttackSet(Square_t square) {
 }
 
 Bitboard_t GetRookAttackSet(Square_t square, Bitboard_t empty) {
+    if(usePext) {
+        return FindSlidingAttackSetWithPext(lookup.rookMagicEntries[square], ~empty, pextAttackTable);
+    }
+
     Bitboard_t blockers = lookup.rookMagicEntries[square].mask & ~empty;
     return FindSlidingAttackSetInHashTable(
         lookup.rookMagicEntries[square],
         blockers,
-        lookup.magicHashTable
+        magicAttackTable
     );
 }
 
 Bitboard_t GetBishopAttackSet(Square_t square, Bitboard_t empty) {
+    if(usePext) {
+        return FindSlidingAttackSetWithPext(lookup.bishopMagicEntries[square], ~empty, pextAttackTable);
+    }
+
     Bitboard_t blockers = lookup.bishopMagicEntries[square].mask & ~empty;
     return FindSlidingAttackSetInHashTable(
         lookup.bishopMagicEntries[square],
         blockers,
-        lookup.magicHashTable
+        magicAttackTable
     );
 }
 
@@ -193,6 +261,14 @@ Bitboard_t GetDirectionalRay(Square_t square, Direction_t direction) {
     return lookup.directionalRays[square][direction];
 }
 
+Bitboard_t GetPassedPawnMask(Square_t square, Color_t color) {
+    return lookup.passedPawnMasks[color][square];
+}
+
+Bitboard_t GetAdjacentFileMask(Square_t square) {
+    return lookup.adjacentFileMasks[square];
+}
+
 Square_t GetKingsideCastleSquare(Color_t color) {
     return lookup.ksCastleSquares[color];
 }
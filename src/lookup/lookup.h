@@ -12,19 +12,28 @@ typedef struct {
 
     MagicEntry_t rookMagicEntries[NUM_SQUARES];
     MagicEntry_t bishopMagicEntries[NUM_SQUARES];
-    Bitboard_t magicHashTable[NUM_HASH_ENTRIES];
 
     Bitboard_t slidingCheckmasks[NUM_SQUARES][NUM_SQUARES];
     Bitboard_t pawnCheckmasks[2][NUM_SQUARES]; // different for each color
 
     Bitboard_t directionalRays[NUM_SQUARES][NUM_DIRECTIONS];
 
+    Bitboard_t passedPawnMasks[2][NUM_SQUARES]; // own and adjacent files in front of the pawn
+    Bitboard_t adjacentFileMasks[NUM_SQUARES];
+
     Square_t ksCastleSquares[2];
     Square_t qsCastleSquares[2];
 } Lookup_t;
 
+// Picks the slider attack backend. The tables themselves are compiled in from lookup_tables.h,
+// unless this is a RUNTIME_TABLES build, where they're built here instead.
 void InitLookupTables();
 
+// builds every table except the slider attacks from scratch, this is what `make tables` prints
+void BuildLookupTables(Lookup_t* lookup);
+
+const Lookup_t* ReadLookupTables();
+
 Bitboard_t GetSingleBitset(Square_t square);
 
 Bitboard_t GetKnightAttackSet(Square_t square);
@@ -41,6 +50,10 @@ Bitboard_t GetPawnCheckmask(Square_t kingSquare, Color_t color);
 
 Bitboard_t GetDirectionalRay(Square_t square, Direction_t direction);
 
+Bitboard_t GetPassedPawnMask(Square_t square, Color_t color);
+
+Bitboard_t GetAdjacentFileMask(Square_t square);
+
 Square_t GetKingsideCastleSquare(Color_t color);
 
 Square_t GetQueensideCastleSquare(Color_t color);
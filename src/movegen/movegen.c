@@ -1,8 +1,17 @@
+#include <assert.h>
+
 #include "legals.h"
 #include "movegen.h"
 #include "pieces.h"
 #include "lookup.h"
 
+// Which half of the moves a pass generates. Queen promotions go with the captures so the quiescence search sees them,
+// underpromotions are rarely worth a look and go with the quiets.
+typedef enum {
+    capture_pass,
+    quiet_pass
+} MovegenPass_t;
+
 #define SerializePositionsIntoMoves(_positions, ...) \
     do { \
         while(_positions) { \
@@ -71,7 +80,8 @@ static void _SerializePawnPromotionsHelper(MoveList_t* moveList, Piece_t promoti
 static void SerializePawnPromotions(
     MoveList_t* moveList,
     Bitboard_t moves,
-    DirectionCallback_t ShiftToPawnPos
+    DirectionCallback_t ShiftToPawnPos,
+    MovegenPass_t pass
 )
 {
     Bitboard_t pawnPositions = ShiftToPawnPos(moves);
@@ -79,10 +89,13 @@ static void SerializePawnPromotions(
         Square_t toSquare = LSB(moves);
         Square_t fromSquare = LSB(pawnPositions);
 
-        _SerializePawnPromotionsHelper(moveList, queen, toSquare, fromSquare);
-        _SerializePawnPromotionsHelper(moveList, rook, toSquare, fromSquare);
-        _SerializePawnPromotionsHelper(moveList, bishop, toSquare, fromSquare);
-        _SerializePawnPromotionsHelper(moveList, knight, toSquare, fromSquare);
+        if(pass == capture_pass) {
+            _SerializePawnPromotionsHelper(moveList, queen, toSquare, fromSquare);
+        } else {
+            _SerializePawnPromotionsHelper(moveList, rook, toSquare, fromSquare);
+            _SerializePawnPromotionsHelper(moveList, bishop, toSquare, fromSquare);
+            _SerializePawnPromotionsHelper(moveList, knight, toSquare, fromSquare);
+        }
 
         ResetLSB(&moves);
         ResetLSB(&pawnPositions);
@@ -239,7 +252,9 @@ static void AddWhitePawnCaptures(
     GameStack_t* gameStack,
     Bitboard_t enemyPieces,
     Bitboard_t checkmask,
-    PinmaskContainer_t pinmasks
+    PinmaskContainer_t pinmasks,
+    Bitboard_t fromMask,
+    MovegenPass_t pass
 )
 {
     Bitboard_t eastCaptureTargets = 
@@ -255,17 +270,20 @@ static void AddWhitePawnCaptures(
     Bitboard_t eastCapturePromotions = FilterWhitePromotions(&eastCaptureTargets);
     Bitboard_t westCapturePromotions = FilterWhitePromotions(&westCaptureTargets);
 
-    SerializePawnMoves(moveList, eastCaptureTargets, no_flag, SoWeOne);
-    SerializePawnPromotions(moveList, eastCapturePromotions, SoWeOne);
+    SerializePawnPromotions(moveList, eastCapturePromotions, SoWeOne, pass);
+    SerializePawnPromotions(moveList, westCapturePromotions, SoEaOne, pass);
+    if(pass == quiet_pass) {
+        return;
+    }
 
+    SerializePawnMoves(moveList, eastCaptureTargets, no_flag, SoWeOne);
     SerializePawnMoves(moveList, westCaptureTargets, no_flag, SoEaOne);
-    SerializePawnPromotions(moveList, westCapturePromotions, SoEaOne);
 
     Bitboard_t enPassantBB = ReadEnPassant(gameStack);
-    if(CanEastEnPassant(gameStack)) {
+    if(CanEastEnPassant(gameStack) && (SoWeOne(enPassantBB) & fromMask)) {
         AddEnPassantMove(moveList, boardInfo, enPassantBB, SoWeOne(enPassantBB));
     }
-    if(CanWestEnPassant(gameStack)) {
+    if(CanWestEnPassant(gameStack) && (SoEaOne(enPassantBB) & fromMask)) {
         AddEnPassantMove(moveList, boardInfo, enPassantBB, SoEaOne(enPassantBB));
     }
 };
@@ -278,7 +296,9 @@ static void AddBlackPawnCaptures(
     GameStack_t* gameStack,
     Bitboard_t enemyPieces,
     Bitboard_t checkmask,
-    PinmaskContainer_t pinmasks
+    PinmaskContainer_t pinmasks,
+    Bitboard_t fromMask,
+    MovegenPass_t pass
 ) 
 {
     Bitboard_t eastCaptureTargets = 
@@ -294,17 +314,20 @@ static void AddBlackPawnCaptures(
     Bitboard_t eastCapturePromotions = FilterBlackPromotions(&eastCaptureTargets);
     Bitboard_t westCapturePromotions = FilterBlackPromotions(&westCaptureTargets);
 
-    SerializePawnMoves(moveList, eastCaptureTargets, no_flag, NoWeOne);
-    SerializePawnPromotions(moveList, eastCapturePromotions, NoWeOne);
+    SerializePawnPromotions(moveList, eastCapturePromotions, NoWeOne, pass);
+    SerializePawnPromotions(moveList, westCapturePromotions, NoEaOne, pass);
+    if(pass == quiet_pass) {
+        return;
+    }
 
+    SerializePawnMoves(moveList, eastCaptureTargets, no_flag, NoWeOne);
     SerializePawnMoves(moveList, westCaptureTargets, no_flag, NoEaOne);
-    SerializePawnPromotions(moveList, westCapturePromotions, NoEaOne);
 
     Bitboard_t enPassantBB = ReadEnPassant(gameStack);
-    if(CanEastEnPassant(gameStack)) {
+    if(CanEastEnPassant(gameStack) && (NoWeOne(enPassantBB) & fromMask)) {
         AddEnPassantMove(moveList, boardInfo, enPassantBB, NoWeOne(enPassantBB));
     }
-    if(CanWestEnPassant(gameStack)) {
+    if(CanWestEnPassant(gameStack) && (NoEaOne(enPassantBB) & fromMask)) {
         AddEnPassantMove(moveList, boardInfo, enPassantBB, NoEaOne(enPassantBB));
     }
 };
@@ -316,7 +339,8 @@ static void AddWhitePawnMoves(
     Bitboard_t hvPinnedPawns,
     Bitboard_t empty,
     Bitboard_t checkmask,
-    PinmaskContainer_t pinmasks
+    PinmaskContainer_t pinmasks,
+    MovegenPass_t pass
 )
 {
     Bitboard_t singleMoveTargets = 
@@ -329,14 +353,16 @@ static void AddWhitePawnMoves(
         (WhiteDoublePushTargets(hvPinnedPawns, empty) & pinmasks.hv))
         & checkmask;
 
+    // a double push can never promote
     Bitboard_t singleMovePromotions = FilterWhitePromotions(&singleMoveTargets);
-    Bitboard_t doubleMovePromotions = FilterWhitePromotions(&doubleMoveTargets);
 
-    SerializePawnMoves(moveList, singleMoveTargets, no_flag, SoutOne);
-    SerializePawnPromotions(moveList, singleMovePromotions, SoutOne);
+    SerializePawnPromotions(moveList, singleMovePromotions, SoutOne, pass);
+    if(pass == capture_pass) {
+        return;
+    }
 
+    SerializePawnMoves(moveList, singleMoveTargets, no_flag, SoutOne);
     SerializePawnMoves(moveList, doubleMoveTargets, no_flag, SoutTwo);
-    SerializePawnPromotions(moveList, doubleMovePromotions, SoutTwo);
 };
 
 static void AddBlackPawnMoves(
@@ -346,7 +372,8 @@ static void AddBlackPawnMoves(
     Bitboard_t hvPinnedPawns,
     Bitboard_t empty,
     Bitboard_t checkmask,
-    PinmaskContainer_t pinmasks
+    PinmaskContainer_t pinmasks,
+    MovegenPass_t pass
 )
 {
     Bitboard_t singleMoveTargets = 
@@ -359,14 +386,16 @@ static void AddBlackPawnMoves(
         (BlackDoublePushTargets(hvPinnedPawns, empty) & pinmasks.hv))
         & checkmask;
 
+    // a double push can never promote
     Bitboard_t singleMovePromotions = FilterBlackPromotions(&singleMoveTargets);
-    Bitboard_t doubleMovePromotions = FilterBlackPromotions(&doubleMoveTargets);
 
-    SerializePawnMoves(moveList, singleMoveTargets, no_flag, NortOne);
-    SerializePawnPromotions(moveList, singleMovePromotions, NortOne);
+    SerializePawnPromotions(moveList, singleMovePromotions, NortOne, pass);
+    if(pass == capture_pass) {
+        return;
+    }
 
+    SerializePawnMoves(moveList, singleMoveTargets, no_flag, NortOne);
     SerializePawnMoves(moveList, doubleMoveTargets, no_flag, NortTwo);
-    SerializePawnPromotions(moveList, doubleMovePromotions, NortTwo);
 };
 
 static void AddKnightAndSliderMoves(
@@ -375,19 +404,20 @@ static void AddKnightAndSliderMoves(
     Bitboard_t checkmask,
     Bitboard_t filter,
     PinmaskContainer_t pinmasks,
-    Color_t color
+    Color_t color,
+    Bitboard_t fromMask
 )
 {
     AddKnightMoves(
         moveList,
-        boardInfo->knights[color],
+        boardInfo->knights[color] & fromMask,
         filter,
         pinmasks
     );
 
     AddD12SliderMoves(
         moveList,
-        AllD12Sliders(boardInfo, color),
+        AllD12Sliders(boardInfo, color) & fromMask,
         filter,
         boardInfo->empty,
         pinmasks
@@ -395,172 +425,404 @@ static void AddKnightAndSliderMoves(
 
     AddHvSliderMoves(
         moveList,
-        AllHvSliders(boardInfo, color),
+        AllHvSliders(boardInfo, color) & fromMask,
         filter,
         boardInfo->empty,
         pinmasks 
     );
 }
 
-static void AddAllCaptures(
+static void AddPawnCaptures(
     MoveList_t* moveList,
     BoardInfo_t* boardInfo,
     Bitboard_t checkmask,
     GameStack_t* gameStack,
     PinmaskContainer_t pinmasks,
-    Color_t color
+    Color_t color,
+    Bitboard_t fromMask,
+    MovegenPass_t pass
 )
 {
     Bitboard_t enemyPieces = boardInfo->allPieces[!color];
+    Bitboard_t pawns = boardInfo->pawns[color] & fromMask;
     if(color == white) {
         AddWhitePawnCaptures(
             moveList,
             boardInfo,
-            boardInfo->pawns[color] & ~pinmasks.all,
-            boardInfo->pawns[color] & pinmasks.d12,
+            pawns & ~pinmasks.all,
+            pawns & pinmasks.d12,
             gameStack,
             enemyPieces,
             checkmask,
-            pinmasks        
+            pinmasks,
+            fromMask,
+            pass
         );
     } else {
         AddBlackPawnCaptures(
             moveList,
             boardInfo,
-            boardInfo->pawns[color] & ~pinmasks.all,
-            boardInfo->pawns[color] & pinmasks.d12,
+            pawns & ~pinmasks.all,
+            pawns & pinmasks.d12,
             gameStack,
             enemyPieces,
             checkmask,
-            pinmasks        
+            pinmasks,
+            fromMask,
+            pass
         );        
     }
-
-    Bitboard_t filter = checkmask & boardInfo->allPieces[!color];
-    AddKnightAndSliderMoves(
-        moveList,
-        boardInfo,
-        checkmask,
-        filter,
-        pinmasks,
-        color
-    );
 }
 
-static void AddAllQuietMoves(
+static void AddPawnPushes(
     MoveList_t* moveList,
     BoardInfo_t* boardInfo,
     Bitboard_t checkmask,
     PinmaskContainer_t pinmasks,
-    Color_t color
+    Color_t color,
+    Bitboard_t fromMask,
+    MovegenPass_t pass
 )
 {
+    Bitboard_t pawns = boardInfo->pawns[color] & fromMask;
     if(color == white) {
         AddWhitePawnMoves(
             moveList,
             boardInfo,
-            boardInfo->pawns[color] & ~pinmasks.all,
-            boardInfo->pawns[color] & pinmasks.hv,
+            pawns & ~pinmasks.all,
+            pawns & pinmasks.hv,
             boardInfo->empty,
             checkmask,
-            pinmasks
+            pinmasks,
+            pass
         );
     } else {
         AddBlackPawnMoves(
             moveList,
             boardInfo,
-            boardInfo->pawns[color] & ~pinmasks.all,
-            boardInfo->pawns[color] & pinmasks.hv,
+            pawns & ~pinmasks.all,
+            pawns & pinmasks.hv,
             boardInfo->empty,
             checkmask,
-            pinmasks
+            pinmasks,
+            pass
         );
     }
+}
 
-    Bitboard_t filter = checkmask & boardInfo->empty;
+// captures, en passant and queen promotions
+static void AddAllCaptures(
+    MoveList_t* moveList,
+    BoardInfo_t* boardInfo,
+    Bitboard_t checkmask,
+    GameStack_t* gameStack,
+    PinmaskContainer_t pinmasks,
+    Color_t color,
+    Bitboard_t fromMask
+)
+{
+    AddPawnCaptures(moveList, boardInfo, checkmask, gameStack, pinmasks, color, fromMask, capture_pass);
+    AddPawnPushes(moveList, boardInfo, checkmask, pinmasks, color, fromMask, capture_pass);
+
+    Bitboard_t filter = checkmask & boardInfo->allPieces[!color];
     AddKnightAndSliderMoves(
         moveList,
         boardInfo,
         checkmask,
         filter,
         pinmasks,
-        color
+        color,
+        fromMask
     );
 }
 
-void CompleteMovegen(MoveList_t* moveList, BoardInfo_t* boardInfo, GameStack_t* stack) {
-    moveList->maxIndex = movelist_empty;
+// everything else, including the underpromotions of pawn captures
+static void AddAllQuietMoves(
+    MoveList_t* moveList,
+    BoardInfo_t* boardInfo,
+    Bitboard_t checkmask,
+    GameStack_t* gameStack,
+    PinmaskContainer_t pinmasks,
+    Color_t color,
+    Bitboard_t fromMask
+)
+{
+    AddPawnPushes(moveList, boardInfo, checkmask, pinmasks, color, fromMask, quiet_pass);
+    AddPawnCaptures(moveList, boardInfo, checkmask, gameStack, pinmasks, color, fromMask, quiet_pass);
+
+    Bitboard_t filter = checkmask & boardInfo->empty;
+    AddKnightAndSliderMoves(
+        moveList,
+        boardInfo,
+        checkmask,
+        filter,
+        pinmasks,
+        color,
+        fromMask
+    );
+}
 
+void DefineMovegenInfo(MovegenInfo_t* info, BoardInfo_t* boardInfo) {
     Color_t color = boardInfo->colorToMove;
 
-    Bitboard_t unsafeSquares = UnsafeSquares(boardInfo, color);
-    Square_t kingSquare = KingSquare(boardInfo, color);
-    Bitboard_t enemyPieces = boardInfo->allPieces[!color];
+    info->unsafeSquares = UnsafeSquares(boardInfo, color);
+    info->kingSquare = KingSquare(boardInfo, color);
+    info->inCheck = InCheck(boardInfo->kings[color], info->unsafeSquares);
+    info->isDoubleCheck = false;
+    info->checkmask = full_set;
 
-    AddKingMoves(
-        moveList,
-        kingSquare,
-        KingMoveTargets(kingSquare, enemyPieces),
-        unsafeSquares,
-        boardInfo->empty
-    );
+    if(info->inCheck) {
+        info->checkmask = DefineCheckmask(boardInfo, color);
+        info->isDoubleCheck = IsDoubleCheck(boardInfo, info->checkmask, color);
+    }
 
-    Bitboard_t checkmask = full_set;
-    bool inCheck = InCheck(boardInfo->kings[color], unsafeSquares);
-    if(inCheck) {
-        checkmask = DefineCheckmask(boardInfo, color);
-        if(IsDoubleCheck(boardInfo, checkmask, color)) {
-            moveList->maxCapturesIndex = moveList->maxIndex;
-
-            AddKingMoves(
-                moveList,
-                kingSquare,
-                KingMoveTargets(kingSquare, boardInfo->empty),
-                unsafeSquares,
-                boardInfo->empty
-            );
-        
-            return;
-        }
+    // only the king can move out of a double check, so nothing needs the pins
+    if(!info->isDoubleCheck) {
+        info->pinmasks = DefinePinmasks(boardInfo, color);
     }
+}
 
-    PinmaskContainer_t pinmasks = DefinePinmasks(boardInfo, color);
+// Generates the legal captures of the pieces in fromMask. Serializing everything except the pieces
+// we care about away is what lets MoveIsLegal reuse the normal generator for a single piece.
+static void AddCapturesFromSquares(
+    MoveList_t* moveList,
+    BoardInfo_t* boardInfo,
+    GameStack_t* stack,
+    MovegenInfo_t* info,
+    Bitboard_t fromMask
+)
+{
+    Color_t color = boardInfo->colorToMove;
+
+    if(boardInfo->kings[color] & fromMask) {
+        AddKingMoves(
+            moveList,
+            info->kingSquare,
+            KingMoveTargets(info->kingSquare, boardInfo->allPieces[!color]),
+            info->unsafeSquares,
+            boardInfo->empty
+        );
+    }
+
+    if(info->isDoubleCheck) {
+        return;
+    }
 
     AddAllCaptures(
         moveList,
         boardInfo,
-        checkmask,
+        info->checkmask,
         stack,
-        pinmasks,
-        color
+        info->pinmasks,
+        color,
+        fromMask
     );
+}
 
-    moveList->maxCapturesIndex = moveList->maxIndex;
+static void AddQuietsFromSquares(
+    MoveList_t* moveList,
+    BoardInfo_t* boardInfo,
+    GameStack_t* stack,
+    MovegenInfo_t* info,
+    Bitboard_t fromMask
+)
+{
+    Color_t color = boardInfo->colorToMove;
 
-    AddAllQuietMoves(
-        moveList,
-        boardInfo,
-        checkmask,
-        pinmasks,
-        color
-    );
+    if(!info->isDoubleCheck) {
+        AddAllQuietMoves(
+            moveList,
+            boardInfo,
+            info->checkmask,
+            stack,
+            info->pinmasks,
+            color,
+            fromMask
+        );
+    }
+
+    if(!(boardInfo->kings[color] & fromMask)) {
+        return;
+    }
 
     AddKingMoves(
         moveList,
-        kingSquare,
-        KingMoveTargets(kingSquare, boardInfo->empty),
-        unsafeSquares,
+        info->kingSquare,
+        KingMoveTargets(info->kingSquare, boardInfo->empty),
+        info->unsafeSquares,
         boardInfo->empty
     );
 
-    if(!inCheck) {
+    if(!info->inCheck) {
         AddCastlingMoves(
             moveList,
             boardInfo,
             stack,
-            unsafeSquares,
-            kingSquare,
+            info->unsafeSquares,
+            info->kingSquare,
             color
         );
     }
+}
+
+void GenerateCaptures(MoveList_t* moveList, BoardInfo_t* boardInfo, GameStack_t* stack, MovegenInfo_t* info) {
+    AddCapturesFromSquares(moveList, boardInfo, stack, info, full_set);
+    moveList->maxCapturesIndex = moveList->maxIndex;
+}
+
+void GenerateQuiets(MoveList_t* moveList, BoardInfo_t* boardInfo, GameStack_t* stack, MovegenInfo_t* info) {
+    AddQuietsFromSquares(moveList, boardInfo, stack, info, full_set);
+}
+
+// The checkmask already limits both passes to moves that deal with the check, and castling is never generated
+// in check, so the evasions are just both passes. Only the king moves when it's a double check.
+void GenerateEvasions(MoveList_t* moveList, BoardInfo_t* boardInfo, GameStack_t* stack, MovegenInfo_t* info) {
+    assert(info->inCheck);
+
+    GenerateCaptures(moveList, boardInfo, stack, info);
+    GenerateQuiets(moveList, boardInfo, stack, info);
+}
+
+// Where each piece type has to land to check the enemy king, and which of our pieces are the only thing
+// standing between it and one of our sliders. A discoverer checks as soon as it steps off its line.
+typedef struct {
+    Bitboard_t checkSquares[NUM_PIECES];
+    Bitboard_t discoverers;
+    Bitboard_t discoveryLines[NUM_DIRECTIONS];
+    int numDiscoveryLines;
+} CheckInfo_t;
+
+static void DefineCheckInfo(CheckInfo_t* checkInfo, BoardInfo_t* boardInfo) {
+    Color_t color = boardInfo->colorToMove;
+    Square_t enemyKing = KingSquare(boardInfo, !color);
+
+    Bitboard_t d12Checks = GetBishopAttackSet(enemyKing, boardInfo->empty);
+    Bitboard_t hvChecks = GetRookAttackSet(enemyKing, boardInfo->empty);
+
+    checkInfo->checkSquares[pawn] = GetPawnCheckmask(enemyKing, !color);
+    checkInfo->checkSquares[knight] = GetKnightAttackSet(enemyKing);
+    checkInfo->checkSquares[bishop] = d12Checks;
+    checkInfo->checkSquares[rook] = hvChecks;
+    checkInfo->checkSquares[queen] = d12Checks | hvChecks;
+    checkInfo->checkSquares[king] = empty_set;
+
+    // sliders that would see the king on an empty board, the ones with exactly one of our pieces in between have a discoverer
+    Bitboard_t snipers =
+        (GetBishopAttackSet(enemyKing, full_set) & AllD12Sliders(boardInfo, color)) |
+        (GetRookAttackSet(enemyKing, full_set) & AllHvSliders(boardInfo, color));
+
+    checkInfo->discoverers = empty_set;
+    checkInfo->numDiscoveryLines = 0;
+    while(snipers) {
+        Square_t sniper = LSB(snipers);
+        Bitboard_t line = GetSlidingCheckmask(enemyKing, sniper);
+        Bitboard_t blockers = line & ~boardInfo->empty & ~GetSingleBitset(sniper);
+
+        if(PopCount(blockers) == 1 && (blockers & boardInfo->allPieces[color])) {
+            checkInfo->discoverers |= blockers;
+            checkInfo->discoveryLines[checkInfo->numDiscoveryLines] = line;
+            (checkInfo->numDiscoveryLines)++;
+        }
+
+        ResetLSB(&snipers);
+    }
+}
+
+static bool QuietMoveGivesCheck(CheckInfo_t* checkInfo, BoardInfo_t* boardInfo, Move_t move) {
+    Bitboard_t fromBB = GetSingleBitset(ReadFromSquare(move));
+    Bitboard_t toBB = GetSingleBitset(ReadToSquare(move));
+
+    Piece_t piece = PieceOnSquare(boardInfo, ReadFromSquare(move));
+    if(checkInfo->checkSquares[piece] & toBB) {
+        return true;
+    }
+
+    for(int i = 0; i < checkInfo->numDiscoveryLines; i++) {
+        if(checkInfo->discoveryLines[i] & fromBB) {
+            return !(checkInfo->discoveryLines[i] & toBB);
+        }
+    }
+
+    return false;
+}
+
+// Only the pieces that can check directly are generated, and only onto their check squares. Discoverers get
+// every quiet move generated and filtered, there's at most a couple of them. Castling and underpromotions
+// are left out, the quiescence search isn't going to miss them.
+void GenerateQuietChecks(MoveList_t* moveList, BoardInfo_t* boardInfo, GameStack_t* stack, MovegenInfo_t* info) {
+    assert(!info->inCheck);
+
+    Color_t color = boardInfo->colorToMove;
+    CheckInfo_t checkInfo;
+    DefineCheckInfo(&checkInfo, boardInfo);
+
+    Bitboard_t directCheckers = boardInfo->allPieces[color] & ~checkInfo.discoverers;
+    Bitboard_t empty = boardInfo->empty;
+
+    Bitboard_t pawnTargets = checkInfo.checkSquares[pawn] & ~(rank_1 | rank_8);
+    AddPawnPushes(moveList, boardInfo, pawnTargets, info->pinmasks, color, directCheckers, quiet_pass);
+
+    AddKnightMoves(
+        moveList,
+        boardInfo->knights[color] & directCheckers,
+        empty & checkInfo.checkSquares[knight],
+        info->pinmasks
+    );
+
+    Bitboard_t queens = boardInfo->queens[color] & directCheckers;
+    AddD12SliderMoves(moveList, boardInfo->bishops[color] & directCheckers, empty & checkInfo.checkSquares[bishop], empty, info->pinmasks);
+    AddHvSliderMoves(moveList, boardInfo->rooks[color] & directCheckers, empty & checkInfo.checkSquares[rook], empty, info->pinmasks);
+    AddD12SliderMoves(moveList, queens, empty & checkInfo.checkSquares[queen], empty, info->pinmasks);
+    AddHvSliderMoves(moveList, queens, empty & checkInfo.checkSquares[queen], empty, info->pinmasks);
+
+    if(!checkInfo.discoverers) {
+        return;
+    }
+
+    MoveList_t discoveries;
+    discoveries.maxIndex = movelist_empty;
+    AddQuietsFromSquares(&discoveries, boardInfo, stack, info, checkInfo.discoverers);
+
+    for(int i = 0; i <= discoveries.maxIndex; i++) {
+        Move_t move = discoveries.moves[i];
+        SpecialFlag_t flag = ReadSpecialFlag(move);
+        if(flag == castle_flag || flag == promotion_flag) {
+            continue;
+        }
+
+        if(QuietMoveGivesCheck(&checkInfo, boardInfo, move)) {
+            (moveList->maxIndex)++;
+            moveList->moves[moveList->maxIndex] = move;
+        }
+    }
+}
+
+void CompleteMovegen(MoveList_t* moveList, BoardInfo_t* boardInfo, GameStack_t* stack) {
+    moveList->maxIndex = movelist_empty;
+
+    MovegenInfo_t info;
+    DefineMovegenInfo(&info, boardInfo);
+
+    GenerateCaptures(moveList, boardInfo, stack, &info);
+    GenerateQuiets(moveList, boardInfo, stack, &info);
+}
+
+bool MoveIsLegal(BoardInfo_t* boardInfo, GameStack_t* stack, MovegenInfo_t* info, Move_t move) {
+    Bitboard_t fromBB = GetSingleBitset(ReadFromSquare(move));
+    if(!(fromBB & boardInfo->allPieces[boardInfo->colorToMove])) {
+        return false;
+    }
+
+    MoveList_t pieceMoves;
+    pieceMoves.maxIndex = movelist_empty;
+    AddCapturesFromSquares(&pieceMoves, boardInfo, stack, info, fromBB);
+    AddQuietsFromSquares(&pieceMoves, boardInfo, stack, info, fromBB);
+
+    for(int i = 0; i <= pieceMoves.maxIndex; i++) {
+        if(pieceMoves.moves[i].data == move.data) {
+            return true;
+        }
+    }
+
+    return false;
 }
\ No newline at end of file
@@ -5,19 +5,50 @@
 #include "board_info.h"
 #include "move.h"
 #include "game_state.h"
+#include "legals.h"
 
 enum {
     movelist_empty = -1
 };
 
+typedef int32_t MoveScore_t;
+
 typedef struct {
     Move_t moves[MOVELIST_MAX];
+    MoveScore_t scores[MOVELIST_MAX]; // the generators leave these alone, move ordering fills them in
     int maxCapturesIndex;
     int maxIndex;
 } MoveList_t;
 
+// everything about the side to move's king that both generation passes need, so it is only computed once per position
+typedef struct {
+    Bitboard_t unsafeSquares;
+    Bitboard_t checkmask;
+    PinmaskContainer_t pinmasks;
+    Square_t kingSquare;
+    bool inCheck;
+    bool isDoubleCheck;
+} MovegenInfo_t;
+
+void DefineMovegenInfo(MovegenInfo_t* info, BoardInfo_t* boardInfo);
+
+// appends every legal capture and queen promotion to the list and marks the end of them with maxCapturesIndex
+void GenerateCaptures(MoveList_t* moveList, BoardInfo_t* boardInfo, GameStack_t* stack, MovegenInfo_t* info);
+
+// appends every legal move GenerateCaptures doesn't, so underpromotions are in here too
+void GenerateQuiets(MoveList_t* moveList, BoardInfo_t* boardInfo, GameStack_t* stack, MovegenInfo_t* info);
+
+// every legal move when in check, captures first and marked with maxCapturesIndex like GenerateCaptures does
+void GenerateEvasions(MoveList_t* moveList, BoardInfo_t* boardInfo, GameStack_t* stack, MovegenInfo_t* info);
+
+// the quiet moves that check the enemy king, directly or by discovery, without castling or promotions. Not for use in check
+void GenerateQuietChecks(MoveList_t* moveList, BoardInfo_t* boardInfo, GameStack_t* stack, MovegenInfo_t* info);
+
 void CompleteMovegen(MoveList_t* moveList, BoardInfo_t* boardInfo, GameStack_t* stack);
 
+// checks a move that didn't come from the generator for this position, like a hash or killer move
+bool MoveIsLegal(BoardInfo_t* boardInfo, GameStack_t* stack, MovegenInfo_t* info, Move_t move);
+
 bool EnPassantIsLegal(BoardInfo_t* boardInfo, Bitboard_t toBB, Bitboard_t fromBB, Color_t color);
 
 #endif
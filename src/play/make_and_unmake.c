@@ -5,6 +5,8 @@
 #include "movegen.h"
 #include "game_state.h"
 #include "lookup.h"
+#include "zobrist.h"
+#include "evaluation.h"
 
 enum {
     pawn_start_ranks = rank_2 | rank_7,
@@ -24,6 +26,50 @@ static Bitboard_t GetEnPassantBB(Bitboard_t toBB, Color_t color) {
     }
 }
 
+static void UpdatePieceHashes(GameState_t* nextState, Piece_t type, ZobristHash_t keys) {
+    nextState->hash ^= keys;
+    if(type == pawn) {
+        nextState->pawnHash ^= keys;
+    }
+}
+
+static void AddDirtyPiece(GameState_t* nextState, Piece_t type, Color_t color, Square_t fromSquare, Square_t toSquare) {
+    assert(nextState->numDirtyPieces < max_dirty_pieces);
+
+    DirtyPiece_t* dirtyPiece = &nextState->dirtyPieces[nextState->numDirtyPieces];
+    dirtyPiece->piece = type;
+    dirtyPiece->color = color;
+    dirtyPiece->fromSquare = fromSquare;
+    dirtyPiece->toSquare = toSquare;
+    nextState->numDirtyPieces++;
+}
+
+// the Record functions keep the hashes and the dirty piece list in the next state in sync with the board
+static void RecordRemovedPiece(GameState_t* nextState, Piece_t type, Color_t color, Square_t square) {
+    UpdatePieceHashes(nextState, type, PieceSquareKey(type, color, square));
+    AddDirtyPiece(nextState, type, color, square, no_square);
+}
+
+static void RecordAddedPiece(GameState_t* nextState, Piece_t type, Color_t color, Square_t square) {
+    UpdatePieceHashes(nextState, type, PieceSquareKey(type, color, square));
+    AddDirtyPiece(nextState, type, color, no_square, square);
+}
+
+static void RecordMovedPiece(GameState_t* nextState, Piece_t type, Color_t color, Square_t fromSquare, Square_t toSquare) {
+    UpdatePieceHashes(nextState, type, PieceSquareKey(type, color, fromSquare) ^ PieceSquareKey(type, color, toSquare));
+    AddDirtyPiece(nextState, type, color, fromSquare, toSquare);
+}
+
+// the part of the hash that doesn't come from pieces, for whatever state is on top of the stack
+static ZobristHash_t CastlingAndEnPassantKeys(GameStack_t* gameStack) {
+    ZobristHash_t keys = CastlingRightsKey(ReadCastleSquares(gameStack, white), ReadCastleSquares(gameStack, black));
+    if(CanEastEnPassant(gameStack) || CanWestEnPassant(gameStack)) {
+        keys ^= EnPassantFileKey(ReadEnPassant(gameStack));
+    }
+
+    return keys;
+}
+
 static void UpdateEnPassantInfo(BoardInfo_t* info, GameState_t* nextState, Bitboard_t fromBB, Bitboard_t toBB, Color_t color) {
     Bitboard_t eastAdjPawn = info->pawns[!color] & EastOne(toBB);
     Bitboard_t westAdjPawn = info->pawns[!color] & WestOne(toBB);
@@ -53,6 +99,7 @@ static void RemoveCapturedPiece(
     ResetBits(GetPieceInfoField(boardInfo, type, capturedPieceColor), capturedBB);
 
     ResetBits(&(boardInfo->allPieces[capturedPieceColor]), capturedBB);
+    RemovePieceFromScore(boardInfo, type, capturedPieceColor, capturedSquare);
 }
 
 static void RemoveCapturedEnPassant(
@@ -64,6 +111,7 @@ static void RemoveCapturedEnPassant(
     ResetBits(&(boardInfo->pawns[capturedPieceColor]), enPassantBB);
     ResetBits(&(boardInfo->allPieces[capturedPieceColor]), enPassantBB);
     RemovePieceFromMailbox(boardInfo, LSB(enPassantBB));
+    RemovePieceFromScore(boardInfo, pawn, capturedPieceColor, LSB(enPassantBB));
 }
 
 static void UpdateBoardInfoField(
@@ -102,6 +150,8 @@ static void MakeCastlingHandler(BoardInfo_t* boardInfo, GameState_t* nextState,
         kingToSquare,
         color
     );
+    RecordMovedPiece(nextState, king, color, kingFromSquare, kingToSquare);
+    MovePieceInScore(boardInfo, king, color, kingFromSquare, kingToSquare);
 
     if(kingToSquare < kingFromSquare) { // queenside castle
         Bitboard_t rookFromBB = GenShiftWest(kingFromBB, 4);
@@ -115,6 +165,8 @@ static void MakeCastlingHandler(BoardInfo_t* boardInfo, GameState_t* nextState,
             LSB(rookToBB),
             color
         );
+        RecordMovedPiece(nextState, rook, color, LSB(rookFromBB), LSB(rookToBB));
+        MovePieceInScore(boardInfo, rook, color, LSB(rookFromBB), LSB(rookToBB));
 
     } else {
         Bitboard_t rookFromBB = GenShiftEast(kingFromBB, 3);
@@ -128,6 +180,8 @@ static void MakeCastlingHandler(BoardInfo_t* boardInfo, GameState_t* nextState,
             LSB(rookToBB),
             color
         );
+        RecordMovedPiece(nextState, rook, color, LSB(rookFromBB), LSB(rookToBB));
+        MovePieceInScore(boardInfo, rook, color, LSB(rookFromBB), LSB(rookToBB));
     }
 
     UpdateEmpty(boardInfo);
@@ -151,8 +205,12 @@ static void MakePromotionHandler(BoardInfo_t* boardInfo, GameState_t* nextState,
 
         nextState->capturedPiece = capturedPiece;
         UpdateCastleSquares(nextState, boardInfo, !color);
+        RecordRemovedPiece(nextState, capturedPiece, !color, toSquare);
     }
 
+    RecordRemovedPiece(nextState, pawn, color, fromSquare);
+    RecordAddedPiece(nextState, promotionPiece, color, toSquare);
+
     AddPieceToMailbox(boardInfo, fromSquare, promotionPiece);
     MovePieceInMailbox(boardInfo, toSquare, fromSquare);
 
@@ -165,6 +223,9 @@ static void MakePromotionHandler(BoardInfo_t* boardInfo, GameState_t* nextState,
 
     SetBits(GetPieceInfoField(boardInfo, promotionPiece, color), toBB);
 
+    RemovePieceFromScore(boardInfo, pawn, color, fromSquare);
+    AddPieceToScore(boardInfo, promotionPiece, color, toSquare);
+
     UpdateEmpty(boardInfo);
 
     nextState->halfmoveClock = empty_set;
@@ -183,6 +244,9 @@ static void MakeEnPassantHandler(BoardInfo_t* boardInfo, GameState_t* nextState,
         enPassantBB,
         !color
     );
+    RecordRemovedPiece(nextState, pawn, !color, LSB(enPassantBB));
+    RecordMovedPiece(nextState, pawn, color, fromSquare, toSquare);
+    MovePieceInScore(boardInfo, pawn, color, fromSquare, toSquare);
 
     UpdateBoardInfoField(
         boardInfo,
@@ -219,6 +283,7 @@ static void MakeMoveDefaultHandler(BoardInfo_t* boardInfo, GameState_t* nextStat
         nextState->halfmoveClock = 0;
         nextState->capturedPiece = capturedPiece;
         UpdateCastleSquares(nextState, boardInfo, !color); // if we captured, we might have messed up our opponent's castling rights
+        RecordRemovedPiece(nextState, capturedPiece, !color, toSquare);
     }
 
     bool pawnDoublePushed = false;
@@ -242,6 +307,8 @@ static void MakeMoveDefaultHandler(BoardInfo_t* boardInfo, GameState_t* nextStat
         toSquare,
         color
     );
+    RecordMovedPiece(nextState, type, color, fromSquare, toSquare);
+    MovePieceInScore(boardInfo, type, color, fromSquare, toSquare);
 
     UpdateCastleSquares(nextState, boardInfo, color);
     UpdateEmpty(boardInfo);
@@ -253,7 +320,13 @@ static void MakeMoveDefaultHandler(BoardInfo_t* boardInfo, GameState_t* nextStat
 
 void MakeMove(BoardInfo_t* boardInfo, GameStack_t* gameStack, Move_t move) {
     SpecialFlag_t specialFlag = ReadSpecialFlag(move);
+    ZobristHash_t previousKeys = CastlingAndEnPassantKeys(gameStack);
     GameState_t* nextState = GetDefaultNextGameState(gameStack);
+#ifdef UNDO_UNMAKE
+    nextState->movePlayed = move;
+    nextState->previousMaterialAndPST = boardInfo->materialAndPST;
+    nextState->previousPhase = boardInfo->phase;
+#endif
     
     switch (specialFlag) {
         case castle_flag:
@@ -270,11 +343,174 @@ void MakeMove(BoardInfo_t* boardInfo, GameStack_t* gameStack, Move_t move) {
         break;
     }
 
+    nextState->hash ^= previousKeys ^ CastlingAndEnPassantKeys(gameStack) ^ SideToMoveKey();
     boardInfo->colorToMove = !(boardInfo->colorToMove);
+#ifndef UNDO_UNMAKE
     nextState->boardInfo = *boardInfo;
+#endif
 }
 
+#ifndef UNDO_UNMAKE
 void UnmakeMove(BoardInfo_t* boardInfo, GameStack_t* gameStack) {
     RevertState(gameStack);
     *boardInfo = ReadCurrentBoardInfo(gameStack);
+}
+#else
+static void PutBackCapturedPiece(
+    BoardInfo_t* boardInfo,
+    Square_t capturedSquare,
+    Piece_t type,
+    Color_t capturedPieceColor
+)
+{
+    Bitboard_t capturedBB = GetSingleBitset(capturedSquare);
+
+    SetBits(GetPieceInfoField(boardInfo, type, capturedPieceColor), capturedBB);
+    SetBits(&(boardInfo->allPieces[capturedPieceColor]), capturedBB);
+    AddPieceToMailbox(boardInfo, capturedSquare, type);
+}
+
+static void UnmakeCastlingHandler(BoardInfo_t* boardInfo, Move_t move, Color_t color) {
+    Square_t kingFromSquare = ReadFromSquare(move);
+    Square_t kingToSquare = ReadToSquare(move);
+    Bitboard_t kingFromBB = GetSingleBitset(kingFromSquare);
+
+    UpdateBoardInfoField(
+        boardInfo,
+        &(boardInfo->kings[color]),
+        GetSingleBitset(kingToSquare),
+        kingFromBB,
+        kingToSquare,
+        kingFromSquare,
+        color
+    );
+
+    Bitboard_t rookFromBB, rookToBB;
+    if(kingToSquare < kingFromSquare) { // queenside castle
+        rookFromBB = GenShiftWest(kingFromBB, 4);
+        rookToBB = GenShiftWest(kingFromBB, 1);
+    } else {
+        rookFromBB = GenShiftEast(kingFromBB, 3);
+        rookToBB = GenShiftEast(kingFromBB, 1);
+    }
+
+    UpdateBoardInfoField(
+        boardInfo,
+        &(boardInfo->rooks[color]),
+        rookToBB,
+        rookFromBB,
+        LSB(rookToBB),
+        LSB(rookFromBB),
+        color
+    );
+}
+
+static void UnmakePromotionHandler(BoardInfo_t* boardInfo, Move_t move, Color_t color, Piece_t capturedPiece) {
+    Square_t fromSquare = ReadFromSquare(move);
+    Square_t toSquare = ReadToSquare(move);
+    Bitboard_t fromBB = GetSingleBitset(fromSquare);
+    Bitboard_t toBB = GetSingleBitset(toSquare);
+
+    ResetBits(GetPieceInfoField(boardInfo, ReadPromotionPiece(move), color), toBB);
+    ResetBits(&(boardInfo->allPieces[color]), toBB);
+    SetBits(&(boardInfo->pawns[color]), fromBB);
+    SetBits(&(boardInfo->allPieces[color]), fromBB);
+
+    AddPieceToMailbox(boardInfo, fromSquare, pawn);
+    RemovePieceFromMailbox(boardInfo, toSquare);
+
+    if(capturedPiece != none_type) {
+        PutBackCapturedPiece(boardInfo, toSquare, capturedPiece, !color);
+    }
+}
+
+static void UnmakeEnPassantHandler(BoardInfo_t* boardInfo, Move_t move, Color_t color) {
+    Square_t fromSquare = ReadFromSquare(move);
+    Square_t toSquare = ReadToSquare(move);
+    Bitboard_t fromBB = GetSingleBitset(fromSquare);
+    Bitboard_t toBB = GetSingleBitset(toSquare);
+
+    UpdateBoardInfoField(
+        boardInfo,
+        &(boardInfo->pawns[color]),
+        toBB,
+        fromBB,
+        toSquare,
+        fromSquare,
+        color
+    );
+
+    PutBackCapturedPiece(boardInfo, LSB(GetEnPassantBB(toBB, color)), pawn, !color);
+}
+
+static void UnmakeMoveDefaultHandler(BoardInfo_t* boardInfo, Move_t move, Color_t color, Piece_t capturedPiece) {
+    Square_t fromSquare = ReadFromSquare(move);
+    Square_t toSquare = ReadToSquare(move);
+    Piece_t type = PieceOnSquare(boardInfo, toSquare);
+
+    UpdateBoardInfoField(
+        boardInfo,
+        GetPieceInfoField(boardInfo, type, color),
+        GetSingleBitset(toSquare),
+        GetSingleBitset(fromSquare),
+        toSquare,
+        fromSquare,
+        color
+    );
+
+    if(capturedPiece != none_type) {
+        PutBackCapturedPiece(boardInfo, toSquare, capturedPiece, !color);
+    }
+}
+
+// takes the move back in place using what MakeMove recorded on the game stack
+void UnmakeMove(BoardInfo_t* boardInfo, GameStack_t* gameStack) {
+    Move_t move = ReadMovePlayed(gameStack);
+    Piece_t capturedPiece = ReadCapturedPiece(gameStack);
+
+    boardInfo->colorToMove = !(boardInfo->colorToMove);
+    Color_t color = boardInfo->colorToMove;
+
+    switch (ReadSpecialFlag(move)) {
+        case castle_flag:
+            UnmakeCastlingHandler(boardInfo, move, color);
+        break;
+        case promotion_flag:
+            UnmakePromotionHandler(boardInfo, move, color, capturedPiece);
+        break;
+        case en_passant_flag:
+            UnmakeEnPassantHandler(boardInfo, move, color);
+        break;
+        default:
+            UnmakeMoveDefaultHandler(boardInfo, move, color, capturedPiece);
+        break;
+    }
+
+    UpdateEmpty(boardInfo);
+    RestoreMaterialAndPST(gameStack, boardInfo);
+    RevertState(gameStack);
+}
+#endif
+
+void MakeNullMove(BoardInfo_t* boardInfo, GameStack_t* gameStack) {
+    ZobristHash_t previousKeys = CastlingAndEnPassantKeys(gameStack);
+    GameState_t* nextState = GetDefaultNextGameState(gameStack);
+    nextState->hash ^= previousKeys ^ CastlingAndEnPassantKeys(gameStack) ^ SideToMoveKey();
+
+    // nothing can repeat across a null move, so the clock restarts to keep repetition checks from looking past it
+    nextState->halfmoveClock = 0;
+
+    boardInfo->colorToMove = !(boardInfo->colorToMove);
+#ifndef UNDO_UNMAKE
+    nextState->boardInfo = *boardInfo;
+#endif
+}
+
+void UnmakeNullMove(BoardInfo_t* boardInfo, GameStack_t* gameStack) {
+#ifndef UNDO_UNMAKE
+    UnmakeMove(boardInfo, gameStack);
+#else
+    boardInfo->colorToMove = !(boardInfo->colorToMove);
+    RevertState(gameStack);
+#endif
 }
\ No newline at end of file
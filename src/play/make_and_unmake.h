@@ -11,4 +11,9 @@ void MakeMove(BoardInfo_t* boardInfo, GameStack_t* gameStack, Move_t move);
 
 void UnmakeMove(BoardInfo_t* boardInfo, GameStack_t* gameStack);
 
+// passes the turn without moving a piece, only used by the search
+void MakeNullMove(BoardInfo_t* boardInfo, GameStack_t* gameStack);
+
+void UnmakeNullMove(BoardInfo_t* boardInfo, GameStack_t* gameStack);
+
 #endif
\ No newline at end of file
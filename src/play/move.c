@@ -16,6 +16,10 @@ void InitMove(Move_t* move) {
     move->data = 0;
 }
 
+bool SameMove(Move_t a, Move_t b) {
+    return a.data == b.data;
+}
+
 Square_t ReadToSquare(Move_t move) {
     return move.data & to_square;
 }
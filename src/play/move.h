@@ -2,6 +2,7 @@
 #define __MOVE_H__
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "board_constants.h"
 
 typedef struct {
@@ -18,6 +19,8 @@ enum specialFlags {
 
 void InitMove(Move_t* move);
 
+bool SameMove(Move_t a, Move_t b);
+
 Square_t ReadToSquare(Move_t move);
 Square_t ReadFromSquare(Move_t move);
 Square_t ReadPromotionPiece(Move_t move);
@@ -14,6 +14,8 @@ void InitBoardInfo(BoardInfo_t* info) {
 
     info->empty = empty_set;
     info->colorToMove = white;
+    info->materialAndPST = 0;
+    info->phase = 0;
 
     TranslateBitboardsToMailbox(info);
 }
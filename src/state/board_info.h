@@ -3,6 +3,9 @@
 
 #include "board_constants.h"
 
+typedef int32_t PackedScore_t; // midgame score in the upper 16 bits, endgame score in the lower 16
+typedef uint8_t Phase_t;
+
 typedef struct {
     Color_t colorToMove;
 
@@ -17,6 +20,10 @@ typedef struct {
     Bitboard_t kings[2];
 
     Piece_t mailbox[NUM_SQUARES];
+
+    // material and PST sums from white's point of view, kept up to date by the make handlers
+    PackedScore_t materialAndPST;
+    Phase_t phase;
 } BoardInfo_t;
 
 void InitBoardInfo(BoardInfo_t* info);
@@ -26,7 +26,16 @@ GameState_t* GetEmptyNextGameState(GameStack_t* stack) {
     nextState->enPassantSquare = empty_set;
     nextState->canEastEP = false;
     nextState->canWestEP = false;
+    nextState->hash = 0;
+    nextState->pawnHash = 0;
+    nextState->numDirtyPieces = 0;
+#ifndef UNDO_UNMAKE
     InitBoardInfo(&nextState->boardInfo);
+#else
+    InitMove(&nextState->movePlayed);
+    nextState->previousMaterialAndPST = 0;
+    nextState->previousPhase = 0;
+#endif
 
     stack->top++;
     return nextState;
@@ -42,6 +51,9 @@ GameState_t* GetDefaultNextGameState(GameStack_t* stack) {
     defaultState->enPassantSquare = empty_set;
     defaultState->canEastEP = false;
     defaultState->canWestEP = false;
+    defaultState->hash = CurrentState(stack).hash;
+    defaultState->pawnHash = CurrentState(stack).pawnHash;
+    defaultState->numDirtyPieces = 0;
 
     stack->top++;
     return defaultState;
@@ -83,9 +95,28 @@ bool CanEastEnPassant(GameStack_t* stack) {
     return CurrentState(stack).canEastEP;
 }
 
+ZobristHash_t ReadZobristHash(GameStack_t* stack) {
+    return CurrentState(stack).hash;
+}
+
+ZobristHash_t ReadPawnHash(GameStack_t* stack) {
+    return CurrentState(stack).pawnHash;
+}
+
+#ifndef UNDO_UNMAKE
 BoardInfo_t ReadCurrentBoardInfo(GameStack_t* stack) {
     return CurrentState(stack).boardInfo;
 }
+#else
+Move_t ReadMovePlayed(GameStack_t* stack) {
+    return CurrentState(stack).movePlayed;
+}
+
+void RestoreMaterialAndPST(GameStack_t* stack, BoardInfo_t* boardInfo) {
+    boardInfo->materialAndPST = CurrentState(stack).previousMaterialAndPST;
+    boardInfo->phase = CurrentState(stack).previousPhase;
+}
+#endif
 
 GameState_t ReadCurrentGameState(GameStack_t* stack) {
     return CurrentState(stack);
@@ -4,8 +4,24 @@
 #include <stdint.h>
 #include "board_constants.h"
 #include "board_info.h"
+#include "move.h"
 
 typedef uint16_t HalfmoveCount_t;
+typedef uint64_t ZobristHash_t;
+
+enum {
+    max_dirty_pieces = 3, // a capturing promotion removes two pieces and adds one
+    no_square = NUM_SQUARES
+};
+
+// one piece that changed with the last move, so NNUE can update its accumulators instead of starting over
+typedef struct {
+    Piece_t piece;
+    Color_t color;
+    Square_t fromSquare; // no_square if the piece was added
+    Square_t toSquare; // no_square if the piece was removed
+} DirtyPiece_t;
+
 typedef struct {
     Piece_t capturedPiece;
     bool canEastEP;
@@ -13,7 +29,18 @@ typedef struct {
     HalfmoveCount_t halfmoveClock;
     Bitboard_t enPassantSquare;
     Bitboard_t castleSquares[2];
+    ZobristHash_t hash; // kept up to date by MakeMove, so unmaking gets the old one back for free
+    ZobristHash_t pawnHash; // only the pawns, for the pawn structure cache
+    DirtyPiece_t dirtyPieces[max_dirty_pieces];
+    uint8_t numDirtyPieces;
+#ifndef UNDO_UNMAKE
     BoardInfo_t boardInfo;
+#else
+    // just enough for UnmakeMove to take the move back in place
+    Move_t movePlayed;
+    PackedScore_t previousMaterialAndPST;
+    Phase_t previousPhase;
+#endif
 } GameState_t;
 
 typedef struct {
@@ -43,7 +70,17 @@ bool CanWestEnPassant(GameStack_t* stack);
 
 bool CanEastEnPassant(GameStack_t* stack);
 
+ZobristHash_t ReadZobristHash(GameStack_t* stack);
+
+ZobristHash_t ReadPawnHash(GameStack_t* stack);
+
+#ifndef UNDO_UNMAKE
 BoardInfo_t ReadCurrentBoardInfo(GameStack_t* stack);
+#else
+Move_t ReadMovePlayed(GameStack_t* stack);
+
+void RestoreMaterialAndPST(GameStack_t* stack, BoardInfo_t* boardInfo);
+#endif
 
 GameState_t ReadCurrentGameState(GameStack_t* stack);
 
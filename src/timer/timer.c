@@ -10,7 +10,7 @@ static Milliseconds_t ClockRead() {
 #else
     struct timespec tp;
 
-    clock_gettime(CLOCK_REALTIME, &tp);
+    clock_gettime(CLOCK_MONOTONIC, &tp); // the wall clock can jump under NTP, this one only ever moves forward
     return ((Milliseconds_t)tp.tv_sec * msec_per_sec + tp.tv_nsec / nsec_per_msec);
 #endif
 }
@@ -11,13 +11,13 @@ enum {
     castle_hash_bitmask = 0b1111
 };
 
-typedef uint64_t ZobristKey_t;
+#ifdef RUNTIME_TABLES
+static ZobristKeys_t keys;
+#else
+#include "zobrist_keys.h"
 
-static ZobristKey_t whitePieceKeys[NUM_SQUARES * NUM_PIECES];
-static ZobristKey_t blackPieceKeys[NUM_SQUARES * NUM_PIECES];
-static ZobristKey_t castlingKeys[16];
-static ZobristKey_t enPassantFileKeys[8];
-static ZobristKey_t sideToMoveIsBlackKey;
+static const ZobristKeys_t keys = ZOBRIST_KEYS;
+#endif
 
 static void FillKeysrandomList(ZobristKey_t* list, int num_entries) {
     for(int i = 0; i < num_entries; i++) {
@@ -25,19 +25,29 @@ static void FillKeysrandomList(ZobristKey_t* list, int num_entries) {
     }
 }
 
+void BuildZobristKeys(ZobristKeys_t* keys) {
+    FillKeysrandomList(keys->whitePieceKeys, NUM_ARRAY_ELEMENTS(keys->whitePieceKeys));
+    FillKeysrandomList(keys->blackPieceKeys, NUM_ARRAY_ELEMENTS(keys->blackPieceKeys));
+    FillKeysrandomList(keys->castlingKeys, NUM_ARRAY_ELEMENTS(keys->castlingKeys));
+    FillKeysrandomList(keys->enPassantFileKeys, NUM_ARRAY_ELEMENTS(keys->enPassantFileKeys));
+    keys->sideToMoveIsBlackKey = RandUnsigned64();
+}
+
 void GenerateZobristKeys() {
-    FillKeysrandomList(whitePieceKeys, NUM_ARRAY_ELEMENTS(whitePieceKeys));
-    FillKeysrandomList(blackPieceKeys, NUM_ARRAY_ELEMENTS(blackPieceKeys));
-    FillKeysrandomList(castlingKeys, NUM_ARRAY_ELEMENTS(castlingKeys));
-    FillKeysrandomList(enPassantFileKeys, NUM_ARRAY_ELEMENTS(enPassantFileKeys));
-    sideToMoveIsBlackKey = RandUnsigned64();
+#ifdef RUNTIME_TABLES
+    BuildZobristKeys(&keys);
+#endif
+}
+
+const ZobristKeys_t* ReadZobristKeys() {
+    return &keys;
 }
 
 void InitZobristStack(ZobristStack_t* zobristStack) {
     zobristStack->maxIndex = zobrist_stack_empty;
 }
 
-static void UpdateHashWithPieceBitboard(ZobristHash_t* zobristHash, Bitboard_t pieceBB, Piece_t type, ZobristKey_t* pieceKeys) {
+static void UpdateHashWithPieceBitboard(ZobristHash_t* zobristHash, Bitboard_t pieceBB, Piece_t type, const ZobristKey_t* pieceKeys) {
     while(pieceBB) {
         Square_t square = LSB(pieceBB);
         *zobristHash ^= pieceKeys[NUM_PIECES*square + type];
@@ -46,36 +56,30 @@ static void UpdateHashWithPieceBitboard(ZobristHash_t* zobristHash, Bitboard_t p
 }
 
 static void UpdateHashWithCastlingRights(ZobristHash_t* zobristHash, Bitboard_t whiteCastleRights, Bitboard_t blackCastleRights) {
-    int keyIndex = castle_hash_bitmask & (
-        (whiteCastleRights >> white_queenside_castle_shift) |
-        (whiteCastleRights >> white_kingside_castle_shift) |
-        (blackCastleRights >> black_queenside_castle_shift) |
-        (blackCastleRights >> black_kingside_castle_shift));
-
-    *zobristHash ^= castlingKeys[keyIndex];
+    *zobristHash ^= CastlingRightsKey(whiteCastleRights, blackCastleRights);
 }
 
 static void UpdateHashEnPassantFile(ZobristHash_t* zobristHash, Bitboard_t enPassantBB) {
-    *zobristHash ^= enPassantFileKeys[LSB(enPassantBB) % 8];
+    *zobristHash ^= EnPassantFileKey(enPassantBB);
 }
 
 ZobristHash_t HashPosition(BoardInfo_t* boardInfo, GameStack_t* gameStack) {
     ZobristHash_t zobristHash = empty_set;
     GameState_t gameState = ReadCurrentGameState(gameStack);
 
-    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->knights[white], knight, whitePieceKeys);
-    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->bishops[white], bishop, whitePieceKeys);
-    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->rooks[white], rook, whitePieceKeys);
-    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->queens[white], queen, whitePieceKeys);
-    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->pawns[white], pawn, whitePieceKeys);
-    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->kings[white], king, whitePieceKeys);
+    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->knights[white], knight, keys.whitePieceKeys);
+    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->bishops[white], bishop, keys.whitePieceKeys);
+    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->rooks[white], rook, keys.whitePieceKeys);
+    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->queens[white], queen, keys.whitePieceKeys);
+    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->pawns[white], pawn, keys.whitePieceKeys);
+    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->kings[white], king, keys.whitePieceKeys);
 
-    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->knights[black], knight, blackPieceKeys);
-    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->bishops[black], bishop, blackPieceKeys);
-    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->rooks[black], rook, blackPieceKeys);
-    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->queens[black], queen, blackPieceKeys);
-    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->pawns[black], pawn, blackPieceKeys);
-    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->kings[black], king, blackPieceKeys);
+    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->knights[black], knight, keys.blackPieceKeys);
+    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->bishops[black], bishop, keys.blackPieceKeys);
+    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->rooks[black], rook, keys.blackPieceKeys);
+    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->queens[black], queen, keys.blackPieceKeys);
+    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->pawns[black], pawn, keys.blackPieceKeys);
+    UpdateHashWithPieceBitboard(&zobristHash, boardInfo->kings[black], king, keys.blackPieceKeys);
 
     UpdateHashWithCastlingRights(&zobristHash, gameState.castleSquares[white], gameState.castleSquares[black]);
 
@@ -84,12 +88,43 @@ ZobristHash_t HashPosition(BoardInfo_t* boardInfo, GameStack_t* gameStack) {
     }
 
     if(boardInfo->colorToMove == black) {
-        zobristHash ^= sideToMoveIsBlackKey;
+        zobristHash ^= keys.sideToMoveIsBlackKey;
     }
 
     return zobristHash;
 }
 
+ZobristHash_t HashPawnStructure(BoardInfo_t* boardInfo) {
+    ZobristHash_t pawnHash = empty_set;
+    UpdateHashWithPieceBitboard(&pawnHash, boardInfo->pawns[white], pawn, keys.whitePieceKeys);
+    UpdateHashWithPieceBitboard(&pawnHash, boardInfo->pawns[black], pawn, keys.blackPieceKeys);
+
+    return pawnHash;
+}
+
+ZobristHash_t PieceSquareKey(Piece_t piece, Color_t color, Square_t square) {
+    const ZobristKey_t* pieceKeys = (color == white) ? keys.whitePieceKeys : keys.blackPieceKeys;
+    return pieceKeys[NUM_PIECES*square + piece];
+}
+
+ZobristHash_t CastlingRightsKey(Bitboard_t whiteCastleSquares, Bitboard_t blackCastleSquares) {
+    int keyIndex = castle_hash_bitmask & (
+        (whiteCastleSquares >> white_queenside_castle_shift) |
+        (whiteCastleSquares >> white_kingside_castle_shift) |
+        (blackCastleSquares >> black_queenside_castle_shift) |
+        (blackCastleSquares >> black_kingside_castle_shift));
+
+    return keys.castlingKeys[keyIndex];
+}
+
+ZobristHash_t EnPassantFileKey(Bitboard_t enPassantBB) {
+    return keys.enPassantFileKeys[LSB(enPassantBB) % 8];
+}
+
+ZobristHash_t SideToMoveKey() {
+    return keys.sideToMoveIsBlackKey;
+}
+
 void AddZobristHashToStack(ZobristStack_t* zobristStack, ZobristHash_t hash) {
     zobristStack->maxIndex++;
     zobristStack->entries[zobristStack->maxIndex] = hash;
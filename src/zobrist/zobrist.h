@@ -12,19 +12,44 @@ enum {
     zobrist_stack_empty = -1
 };
 
-typedef uint64_t ZobristHash_t;
-
 typedef struct {
     ZobristHash_t entries[ZOBRIST_STACK_MAX];
     int maxIndex;
 } ZobristStack_t;
 
+typedef uint64_t ZobristKey_t;
+
+typedef struct {
+    ZobristKey_t whitePieceKeys[NUM_SQUARES * NUM_PIECES];
+    ZobristKey_t blackPieceKeys[NUM_SQUARES * NUM_PIECES];
+    ZobristKey_t castlingKeys[16];
+    ZobristKey_t enPassantFileKeys[8];
+    ZobristKey_t sideToMoveIsBlackKey;
+} ZobristKeys_t;
+
+// only does anything in a RUNTIME_TABLES build, otherwise the keys are compiled in from zobrist_keys.h
 void GenerateZobristKeys();
 
+// draws a fresh set of keys from the RNG, this is what `make tables` prints
+void BuildZobristKeys(ZobristKeys_t* keys);
+
+const ZobristKeys_t* ReadZobristKeys();
+
 void InitZobristStack(ZobristStack_t* zobristStack);
 
+// hashes the position from scratch, MakeMove keeps the hash in the game state up to date incrementally
 ZobristHash_t HashPosition(BoardInfo_t* boardInfo, GameStack_t* gameStack);
 
+ZobristHash_t HashPawnStructure(BoardInfo_t* boardInfo);
+
+ZobristHash_t PieceSquareKey(Piece_t piece, Color_t color, Square_t square);
+
+ZobristHash_t CastlingRightsKey(Bitboard_t whiteCastleSquares, Bitboard_t blackCastleSquares);
+
+ZobristHash_t EnPassantFileKey(Bitboard_t enPassantBB);
+
+ZobristHash_t SideToMoveKey();
+
 void AddZobristHashToStack(ZobristStack_t* zobristStack, ZobristHash_t hash);
 
 void RemoveZobristHashFromStack(ZobristStack_t* zobristStack);
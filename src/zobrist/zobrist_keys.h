@@ -0,0 +1,216 @@
+#ifndef __ZOBRIST_KEYS_H__
+#define __ZOBRIST_KEYS_H__
+
+// generated by `make tables`, don't edit by hand
+
+#define ZOBRIST_KEYS { \
+    .whitePieceKeys = { \
+        0x152ca78d027c6003, 0xcb07bbf3f98befee, 0x1cd777e3a4e29590, 0x661e4b6d093b9e0e, \
+        0xb7e9851de71f2e4d, 0xbdb2a071469753f2, 0xd4195b448d5b2e0a, 0xe749bf467370bb1c, \
+        0xb9ad21f8cfad21e0, 0x843fa922f16b535e, 0x8be6e048dd7e3483, 0xd136c7ea7886b716, \
+        0xdeafd023a56eeebd, 0x449dff2a30a8f133, 0x5fb4f0ef0e8c4479, 0x1b2326a7ab7f98df, \
+        0x12423bb8bc693c36, 0x6a3430a153aeb48e, 0xd0b0846f07b30dc1, 0x3daa400eee475503, \
+        0xcbd061156b442912, 0xa21b7bf2a1497036, 0xdbaa7d4cee844a19, 0x1242149f9b7f2319, \
+        0x13b5574adacbbda7, 0x6e6f51acbb2ce758, 0xa40b4c7952a17060, 0x82810ae9ba62b903, \
+        0x216bcb520c78819d, 0x586ebe6fe539ce35, 0x2bf68cef2aca379a, 0x249ca1dd9823ce15, \
+        0x40faab65e382c24e, 0x35636845d2e38084, 0x914b5c23755bfb5c, 0xefc5eada752a8073, \
+        0x55a2c490ae755d8d, 0xf6295e62e066a750, 0xdc6fcd8b269948c6, 0x0c34ddffe95a401c, \
+        0xf90e404a4d9e2ed2, 0x31146cd485d595dd, 0x2671f80201039001, 0x9696a2860833f03d, \
+        0xd132f08daa8f5d48, 0xf4cdd3ec3d9f75d5, 0xe9cb0fa50333d581, 0x26f5cbf2e6e318a5, \
+        0xc1b495a72c165c7b, 0x8ef4a4602fb3b822, 0xded1f339bb0f2779, 0x993a456caf4adfc5, \
+        0x81befafcd2782e01, 0xa31969a4d162454b, 0xaeb32e052b574d96, 0x457594d45c6b9dae, \
+        0x58aed378957f1712, 0x456acaf804e34857, 0x5c5fe2b4fce85f57, 0x1579d5bacb84f4fa, \
+        0xd60e4d1b12bf8237, 0x9dacac4239c33b82, 0x2ea83e2f06305065, 0x2c09559e7069564b, \
+        0x0388ada613bf868e, 0x3856f6d16f306183, 0x0f4974e31c56c0f0, 0x499e5d6315423dbd, \
+        0x407fc8a0a9c97b23, 0xdfdffdb174b65c7c, 0x11efa3934bf1609f, 0x24666240d5abb7da, \
+        0xf6ff5afb4ce224b4, 0x07bfbf6df92e8326, 0xec098605a64df396, 0x365a58670e2d8454, \
+        0xaf98eae603f6076d, 0x55c3bd380007c9bb, 0x9b8fc18f52667654, 0xa505ec9514e76502, \
+        0xc56f9a27a1c0d691, 0xd1be021587fd6765, 0x38488a79b0e92730, 0xc7b7991aaec5501c, \
+        0x8a30014fad0f78ab, 0x5b55ca177d534328, 0x24d4bf4be4a0a4ea, 0xd34779485091bbca, \
+        0xd5652aceb7ae7ff5, 0xc8286a8d11f06d6f, 0x16c2fcbe1b056dee, 0x8682ad52d8ed7ce4, \
+        0xd3baa41fc512730b, 0x06e98ce61ebb80d8, 0x1fc324a23ae73691, 0x31c92de074c190d2, \
+        0xbd01a22cd7853911, 0x4b6c61d6617f2bf4, 0x7fec94a223b4df61, 0x6e313ca3a581a91f, \
+        0x865e364046d33a4a, 0x3b69032f4e5c79b8, 0x119fb6db12e9ec15, 0xf58379dcb8050454, \
+        0x0a17d9be7f772c04, 0xe11068e9859fb1de, 0x66915631566194b8, 0x0e9bc96a25f0ec0a, \
+        0x068a4b0d812aca2b, 0x96099ea71280bac3, 0x9d90e17f23479d99, 0xf4a59874a640945f, \
+        0x6e386ccd8ae7965c, 0x9623da018d878907, 0x3f52e398237673b0, 0x99de2c2503a32d0c, \
+        0x647cd5f42f3a418e, 0x70e415f5bb5054ee, 0x97135f89bea5f514, 0xcaecd59f102724ab, \
+        0xcd597253ce46fb98, 0xbc55f6fadd3188d6, 0x9528a70e641ac279, 0xcf4f0ce51f8a509d, \
+        0xcce7797c1aff28ca, 0xef7d31c7e9512931, 0x9f5f01d894a3faf9, 0x28f9d8bdd2bb5c90, \
+        0x596b90784542ca72, 0xd020ad805b7fa978, 0xc7f6b700ac3ae156, 0x88ab89176b63ebb8, \
+        0x6ffcf8448ef8fff7, 0x634e6c3e4ae57945, 0x461e61c3358a62bc, 0x78c015d7c8b8b786, \
+        0xe34066a818f47ad1, 0x4a15454c4f923eba, 0x7e70e7719b7cdc35, 0x6312ff08aebfa9e7, \
+        0x9ce482bdacfb1fa7, 0x2557e13d9731457c, 0x46d16c064ee1a562, 0x1daa9a88f9f3b28c, \
+        0x28a6f67e1b46976b, 0x76059f3c7de5dc70, 0x89b026c64f406cd6, 0xcc8bdd542a9bfc96, \
+        0x6aaffab897a28d8c, 0xc5c96ff43014e9cc, 0x249a80f44eba915a, 0xa5e4e46bf4e4dab7, \
+        0xa66b5bbebd831d10, 0x2dea2a2d42bc9b46, 0x2329591e1e71572f, 0x1e68399fe6d1718b, \
+        0xe2454c5791da61c4, 0x52b58a04762d3594, 0xf869caa5c0544dba, 0x28b6fb8adf7feb5a, \
+        0xf3ad31879b4a63cd, 0xff0222b1dc95350e, 0x33ac4670575300e9, 0xa1dcfa1c06922da2, \
+        0x180202a5a8e96ebe, 0x26d96ca0bafa84c0, 0xdd97048fa78e3c14, 0x9b92d93dd8720dbb, \
+        0x31397ab97da59374, 0xd6b460bbe1d2394f, 0xf043487fd3678245, 0x97d9b5f9febbd7a0, \
+        0x2877a12b3435e890, 0xc3537839032304f8, 0xed7ebfa99aa1aa08, 0x4bd72e732aad509e, \
+        0xb69d3a4c13508f3b, 0x977a6549bcf9f08f, 0x4b36afdfda0374d4, 0x5755f0cc21584c47, \
+        0xba9acd11acc3e15c, 0x70af99022841541c, 0x5a102ccce3aafa8f, 0xe064fce864a6fba2, \
+        0xa7c879673b8bea9d, 0x51f6db2c06df93c8, 0xa944c4a4e9f6c3a2, 0xdee30db26bfe5086, \
+        0xddd929f9e74bd759, 0x093cb076c02d3b65, 0x8db9c7c58cdaec1b, 0xe84fb80545993270, \
+        0x957863967940640b, 0x58b245af7bd1b4e5, 0x37fa02da98e15775, 0x009d29532a3ad71b, \
+        0x2a7b8ebd2facf0bf, 0x255d3a65cdfd0a2a, 0xf70437e5a4781107, 0x0eb2e3684b99ecca, \
+        0x98cfe65826142544, 0x3df39721dc59b4e7, 0xaacb9c28d6793f67, 0x11289db3c649980e, \
+        0x529dd72819cd2f9f, 0x9cba397cbaeff91c, 0x8a14246daaf63aa1, 0x3f64411bb77cb6a0, \
+        0xb65b1adf9b7b5e0a, 0x4fe9b634004b95de, 0xa981b25181ea4534, 0x91cc25fac7613cdf, \
+        0x9a2df29858133f07, 0xc4dc7a5865cba158, 0xf1e166fc98a2d59f, 0xf9b49d5c94e13736, \
+        0x90e15e5fa19313ac, 0xcedf810e25e51c20, 0x98b2066280724299, 0x28ad6ccac5addecf, \
+        0x59f761604f24c5ab, 0x100c5c3d9c91773a, 0x8c7b8f85b66b7a02, 0x9514de58752d37ba, \
+        0x4d3b0dbbc5d77a1c, 0xe73cabdfcd5e1aca, 0x1adcf11908448030, 0xd406af9e5a6aed44, \
+        0x54673598ab1fbe6f, 0xa0dba31e706dfd17, 0xf49786a191a96530, 0x93db79bfdc680039, \
+        0xbe34343545448f7a, 0xbd36041d123a8c6b, 0x5835b8f0a6a9dfe6, 0xd9cf8e7faee354c0, \
+        0x595864ae27dea7c6, 0xfa749b11fc5baf9a, 0x4b47ab0f1d532932, 0x42030322b68358d8, \
+        0x5012221fe10be6ec, 0x3dda7491d30b0c60, 0x241a5913709ff25a, 0x129b1a397038f4b3, \
+        0x8f33f91d218f45a9, 0xadda7d47af65396b, 0x1795fd327b0b84ca, 0x3b39f9da7d049689, \
+        0xbd7ad191e9089831, 0xa9263c87c884ed8f, 0x566b3aa8176a6ea0, 0xb57a8906048f1f2a, \
+        0xbfe47828666a438b, 0x9b5d9314bdce5cde, 0x6454b5d1ce278556, 0x25ba1398c765b714, \
+        0xdf83d2f588849a0b, 0x74f66468636d291c, 0x39e5e7ab093f5cc0, 0x2c53fff7eeaa5763, \
+        0x9638cd1d135e76a7, 0x362063657138388d, 0xf12f826b01fa48a2, 0x91027218a8e3f4fa, \
+        0x4cbaa877707bb1df, 0xa7d72efe7b5356d4, 0xd856fcfeb1dd14c5, 0x6abd5b70ab0f98a9, \
+        0x256000f73491d0e4, 0xfd94d58e2f7680c7, 0x8500d2ef66b2a98e, 0x009651e779b687a7, \
+        0xfcb2ff5b38ec2b98, 0x13e765de10034b9d, 0x13f75185d9cf36c7, 0x239e002b1255aaa8, \
+        0x27d3b36a776c28e2, 0x46cebdf48b438220, 0x57ce7ec9623ac89f, 0xd74a361c2bc7a66c, \
+        0x5dd7e4f39f779f8b, 0xb59c257c33c9ad17, 0xa1dec5d9e7412727, 0x30ae2e63fc1147e3, \
+        0x657ab2dbcda2b395, 0xe40a9d9aa4dd96e1, 0xcf267aeb4a156283, 0x4b0f55f2058063e1, \
+        0xfc9e0521efdd8d60, 0x8b9c6202edce13cf, 0xc00013d0b318b49a, 0x435769fb70385c7c, \
+        0x6bfe8fe0c4822e3a, 0x5b8224a36c7bb96d, 0x037c6b8fe8d1f6fb, 0x249aa77bd0b88dcf, \
+        0xb65dee08be4d1aed, 0xd3b71ab2ae2b7ae2, 0x20ca3b85283669a6, 0x71c16e33f4a74c6c, \
+        0x94c1e5a20f774273, 0xa2b91e618b1f2fac, 0x99bf75a157246714, 0x72e12a65742e3d7a, \
+        0x11f586b7441be654, 0x4122e49ce632e9ee, 0x6769ffa3f384fbf4, 0xb1c251750ddf6862, \
+        0x67da1474f04fda0c, 0xee267d2e18b17508, 0xb42d36dc51662c84, 0xa424d97e1d331e63, \
+        0x3b16a8a69582a8d6, 0x2b19f3003be09111, 0xf37509fd6d84beef, 0xf17b9cbb7fe4a10c, \
+        0xb25709b5bb68fd42, 0x72a45c1895f1466f, 0x26e34e61ae10818d, 0x6ab6dbe3a2bf604a, \
+        0x9a19d8576f16b88f, 0xf6d88714dc204480, 0x949ac028341fa8b4, 0x4925d3751427aec8, \
+        0x1f4f5b1c41591b04, 0xcb30f2df921705c7, 0x30cf7bf91e0f11b5, 0xd17996e6590f0c23, \
+        0x6c3ed8dec4609bda, 0xad55bb0c00de801c, 0x881d1f9b7fe31230, 0xed47d4096f327af0, \
+        0xd2aeb0c167bffb21, 0x7539244d50023247, 0x0e939ae6bf3e3c2c, 0x03e8e2597f4529ec, \
+        0x32d91383d8b1d268, 0xc8490030aa5e7d25, 0xe066631dd200ca64, 0xb49225fd8e512ec2, \
+        0x82841b0e809d76a4, 0x1b2f4480c2a28f30, 0xb269169892caff44, 0xb36ec55d8c2d6f06, \
+        0x7fee2bec8a5367bb, 0xfda6e8f5e5310f59, 0x91c3c40e71b95bb4, 0xd53c1cfe5591d658, \
+        0x139856360d832ad9, 0x593badf105594c2b, 0xa2892035f91ed4ff, 0x18fa82337adcbe1b, \
+        0xb1f82f5fef980d96, 0x00950a7e6e2d4186, 0x100d72cb775690be, 0xd54fc0ddb0457244, \
+        0x7e5b9443338e059d, 0xf08e0988232219a0, 0x479d0152ae184e33, 0x914927a3bd8ee15a, \
+        0xad34c66edf6483a9, 0xd82399587afce2c5, 0x467c71235e3b2c82, 0x02a2ccf293fee176, \
+        0x4b20faab112a59e4, 0x536f21e3e7d0cf50, 0x4af9484ababa2494, 0x1be1a0827704e71d, \
+        0x91ce6804b59cf8aa, 0xb458bf10c3fcae6e, 0x043552a45242533f, 0x5f4300b4faf79c39, \
+        0xac14f0a74c1188c1, 0x55953fe74a02f2ff, 0xc6b49760bdb96b86, 0x871c47294e599878, \
+        0xc51aece76d76e600, 0x9934b2cf40ba730c, 0xabfff1797664982e, 0x27f5970c678308ba, \
+        0xff5ec989e9ae1f19, 0xe8939de0c47edef1, 0xf2b314076220dee0, 0x7502ccf9c995d2a5, \
+    }, \
+    .blackPieceKeys = { \
+        0x1c7a5d96c98e496e, 0xa1b12750f69cf295, 0x08c93e12728b3696, 0xe432bf4796759045, \
+        0x3a4ecd066b29b07e, 0xa932954ec99690bc, 0xd2c955b37cd97942, 0x4ccdcf7b90b352c0, \
+        0x0e606bbb22522a6a, 0x804cfd5f96d82d53, 0x6b517c911837b5cd, 0x3faf12c0b28b53e0, \
+        0xdf4d7804af7ae839, 0x31dae1ca13e24642, 0x4526507c698dd0f8, 0x975e38437aef7474, \
+        0x4e9bb7c01597502b, 0x106d5925670bd036, 0x36268d6f28b6afec, 0xb8498b8699c59342, \
+        0xb8607f4578a018d1, 0x10d3edd003db150b, 0x34adc26eb9544b4c, 0xa2d6a83690cc2ef6, \
+        0x59475b3e11cd34d8, 0xb114f1177c1898b3, 0x4ecd443b6687df7e, 0x47a43375818737ea, \
+        0x7605673016ecae71, 0xfe1bc1470925629e, 0x8259b962306ae14e, 0x30e2c4016102e151, \
+        0x677153c5fe67ad7a, 0x5cf635b1d67e4298, 0x8bd14a9e54f71285, 0x598a5a61b5e9703a, \
+        0x147ce164e89df897, 0x86d5b7294b0e9c96, 0x483b36318d01251f, 0xb28b93fad6ed4f59, \
+        0x4239fd9d773fcc8b, 0xf53a1ec124c210d7, 0x3a49a1ade743fe4d, 0xc4fdb718c682a292, \
+        0xc22a49e753e0a6d5, 0x543f9a2f4ddbda93, 0xec1b958933950d5e, 0x78c6df4492b3c4a4, \
+        0xbb68f7b684c93909, 0x61e9796008204622, 0x86a39a8bb03f1977, 0x88df7a8d4fed6926, \
+        0xe59d565e5721ac23, 0x0c4016f44bb30d72, 0xc9758963bd913c36, 0xcf36575cde851023, \
+        0xbcf9be7d9c09ddfa, 0x4e451d9e6ced10a6, 0xacd31fd966a8da0d, 0x081c2985e1e3001f, \
+        0x70f20034839c5e4d, 0xdc625745e3727cf8, 0xfd018e16c0db5f23, 0x1ced730abd6ed45b, \
+        0x6ef15a28e0f9bd49, 0x4f0421afc0c82c31, 0x22369bf8d05dca8f, 0xdc1babbabe130458, \
+        0x9d20f81bcb4b56af, 0xc0630659f779a9da, 0x965e2a55d22f76e8, 0x457a25e45e536908, \
+        0xa500c7cd8429c49f, 0x269e4b02a64129ab, 0xc9b9dea1dda06196, 0xafebd904cfa1c0c2, \
+        0x1703de72a95969d4, 0xaa2604c9bb606fdc, 0xf0acd89107ad8913, 0xa6805d9736301951, \
+        0xf6be910a5220d7b2, 0xb5d1e79b5b481aee, 0x271df760914af640, 0xe4fbb0d2f0c85854, \
+        0x9cddfb73a742c046, 0x4b467acc8ac04147, 0x8a1e7391070a4c37, 0x16ee8423973d22eb, \
+        0x9942a4396d974082, 0x740cf4a071981677, 0x6f0038f04e6a168f, 0x1c8ad32ed9e936e1, \
+        0x15c48363d2fb182c, 0x7bc4bbf9b242401b, 0xabf740c3e96294e9, 0xfd9a714a12c051d1, \
+        0xf8406a0680d6accf, 0xb9a788728acfc837, 0xc4b4c31432e993e1, 0x4171d5e812f4049d, \
+        0x3399c963a4254777, 0xab8d4bdb62b4069e, 0x98f3469957b23f61, 0x9051808abddc29d8, \
+        0xd42c4180ddef95c3, 0xdb44a6fdfa877d5c, 0x3c254872de56b517, 0xeafb3c909c5eed42, \
+        0x5de30e912205e210, 0x25b912ca8d72ea0f, 0x9125cc3ae26df3c6, 0xd946664d542fa5ea, \
+        0x150e6e354d18428b, 0xb75991beeb07cda8, 0x9402e73eb61173ac, 0x299dd7c81e78083d, \
+        0xd901a73eddf5c49a, 0xade03a033b8e0066, 0x02956b2c0c9d536c, 0x7d23e3b988784ae7, \
+        0xaa3dc90dd8548c0d, 0xfeab2bfe52412e52, 0xf3ef704098247e6d, 0x1fa48312330bbcf8, \
+        0xcdb5425e5c31ac3e, 0xba33908ce4d3e13d, 0x5773ffc4ceeeaf78, 0xfc003763f4c7713f, \
+        0xa6c48290cf3e2aee, 0xb7b5303c98dd0037, 0x27c9e510b33afee4, 0x7a0aa082c864b4fd, \
+        0xff69b2bf4faaf9a0, 0x170625a0f871e884, 0x7d3570430153a3a7, 0x6c6de6f374778668, \
+        0xb9fffd5566376f8f, 0xf3ec84283459e206, 0x96d2305bc0b831f1, 0xdad3f0c6195ba4e3, \
+        0xb35b1cf2eebd7b00, 0x3a682a41b113c11f, 0xa095538b79b47b24, 0x93ca708e2cd58f20, \
+        0x3f6c82927fb58792, 0x8891a8cdc30a2252, 0x252177f47e600cd7, 0x0fc4ae63447ff23f, \
+        0xec1020febd7489a7, 0xffce95e2c805f1b8, 0x4d5d3a633e571feb, 0xfc2db1119d0a0ed9, \
+        0xc252744a469c66b1, 0xf5b09a1f867e2de7, 0x093fbd40ae28b614, 0xf5967e35f532a9f6, \
+        0x16649101b6179c86, 0xd79b1307cb2c9117, 0x1e46ec07ba6675c2, 0x662ea2914ea34d4a, \
+        0x47cf38181299d595, 0xf310be2a6816da8d, 0xfeaeea11d8c108a5, 0xecb2bc30fca606cf, \
+        0x206760a2f237737e, 0x291736dc46b9f62b, 0x2186d1860e4344ce, 0xcd22d471e31fc233, \
+        0xa47a2c98b1f00801, 0xe54f214dc6e9eb0a, 0x5496f13e56842613, 0x0c168cad8cc24b62, \
+        0xd86d67c5885dd0d5, 0xc789f9d7c923a17e, 0x976b0468df63208d, 0xdcad3ba2a127404e, \
+        0xc202e2382f249768, 0xcb900cbc130bd187, 0x27e32c90b94a037b, 0xaaeeb81eb4e872af, \
+        0xc78f21a9378e32b1, 0x3d2a95a0e48a8310, 0x0978deef941393c6, 0x841d5b2e7e667d73, \
+        0x5d83235591838d36, 0x2eb448780e21ecc6, 0xdfc8ce06573e1887, 0x733983321b7ebd45, \
+        0xd250a030e1d007ab, 0xdfdc906af4dc76f0, 0x8d099c082db36811, 0x276b01e8602d6f55, \
+        0x64f44567d8bccbfd, 0x4eba625d84f10ce9, 0x6bf59ee7baa1a897, 0x2ab85e74db3d175e, \
+        0xdd9064e4f550f0e8, 0x24067b0ee29716b6, 0xdab49e5d6dcb43ae, 0xfadf6403359a97f2, \
+        0x462ca954322f85af, 0x195f8f25fa9139d4, 0x8e69c3c72e162e61, 0x70070481c9c6fec8, \
+        0x0ef4a8b44008ddde, 0x29fa4c4a0f5e7cfb, 0x9b0870714bb13d28, 0x04070342a061df99, \
+        0xb1400edea46946a2, 0xec109a69dbe98776, 0xa0a3dc71c5497cd6, 0xf611de58ab245ea5, \
+        0xe267044bcbff10b1, 0xaad3d55e370404d6, 0x5d16437717919143, 0x11679f29ae431c50, \
+        0x693f104a9b94e4fe, 0x622ebb3798dd4904, 0x3a95d1954b6eb59d, 0x22194264a28be113, \
+        0xb4efddbec09a25f9, 0x71767da6d7c45ae9, 0xb7904c33f1e72962, 0x509bbdd2c8b91710, \
+        0xcbb44ed22b88c1f7, 0x3088192535eeb622, 0xd5e24ae29578da5e, 0x0bf81c9e562ec21c, \
+        0x300a126094bf3caa, 0x92a0161f6b9f582e, 0x13e4147a9fe8c714, 0xddf49dcac96fe6f4, \
+        0x2c8692e049179330, 0x8b43c54104ff151c, 0x0874c860e3b88132, 0x82e0e8bfb74dad23, \
+        0xc0bd72516d2928e4, 0xb92fdb90a5efe28e, 0x001185dd0f8c9bc8, 0xb79f95e73d71afb3, \
+        0x9fc9c9c4733ba307, 0x76ccd0422831672e, 0x3af0f378626b7203, 0x58e31ed8b22c115f, \
+        0x56e26e05531851e4, 0x46432200a5639c8d, 0x7a423240f794bff0, 0x30f59d49b0b2bc0c, \
+        0xd5ac425e165177b8, 0x3b31f0f2a115046c, 0xa0261a66de244208, 0x9acfb357826394c9, \
+        0x25a05ecd3a4c149b, 0xc0db6c7e7fb5ade9, 0x6bd612c8a2423d5b, 0x4895329c48a08453, \
+        0xccd409a4a23cf8d2, 0xdd1e8acbe07ad2a5, 0x6216ff71e34d904e, 0xe82b264a1f33b6a6, \
+        0xa98022ed1d41bb7b, 0xcbbf8c711a66e9c4, 0x89e387abc341fc75, 0xa490b7729a59dd48, \
+        0x2d783c8b33300f79, 0xdf1d16d17d834431, 0x59e82b86008308a3, 0x8aa9dcb9c0d279a7, \
+        0x3322a8f6b0d589af, 0x58ee820cde4ee08d, 0xb1513b11d54ef182, 0x1a7899e7ac3aa064, \
+        0x9e01671746c97794, 0x89ec15f01f7463c1, 0xc02027893ff0ca66, 0x5dab53fc2501fb62, \
+        0x830db1cc8b06fb1c, 0xc391821eb04d0def, 0xc3ba5f322cec9883, 0x9587ecf6de14ec6a, \
+        0x948bce892b022e9c, 0x30c25e285bd1752e, 0x8da615e42fce264a, 0x4c59e7de9c6bb5a2, \
+        0x2b5bda7d05f0bc83, 0xde96ca23c0931650, 0xe9be886489a77ec6, 0x92be0aaf2fddc9e7, \
+        0x75c10a67237cc881, 0xcc44aa9d10f85d12, 0x92b510a61a664f74, 0xbffa81c0c38030b1, \
+        0x95445415a057ff27, 0x8282e0f2f4bf26f1, 0x85e605c8c74702fd, 0x91f833551b993000, \
+        0xf63c22e6c4c6fbfa, 0xd7041228fb492689, 0xd742a419d73e45b3, 0x4749bdefe8453bda, \
+        0xebe21da79ab4e8dc, 0x529f387f17ef347c, 0xe4df93617520e775, 0xe496a9dcf2087d1b, \
+        0x6d37438b10094f67, 0xfa97a4144bcdc564, 0xe464e2f6dfdf663c, 0x4ea5166b0043aecc, \
+        0xc8a1008d3ef2852f, 0x67192e18887510a2, 0x676abb31e4a81222, 0x256aa37cb7543021, \
+        0xa20e4cc333e06f9f, 0xde0e3befae33e9cf, 0x30c871252bbfdae9, 0xe5a6df792737c91f, \
+        0x91d7482e7c6cce04, 0x2290eb59cdf93f9d, 0x5f2c5876717826fd, 0xb18ebcd3d60c5dc6, \
+        0x00c27d396f6b7a0b, 0x1cfecd562f3a8104, 0x24c20390c3cd7f54, 0x5092d1b3e14553b4, \
+        0x29f468f0a2cc2727, 0xdc87b004106382b2, 0x878b4caa5194a943, 0x1013d9b7ed24eb3d, \
+        0x95b2876b3f9ff12d, 0xa2321ead334c5aad, 0xbef4a50c5b8aa3e1, 0x96fe915aa20016ff, \
+        0x44334644f203d087, 0x085985818b04b2c1, 0x94d5d9d23b00bae5, 0xbffe5dad0b9a4fc2, \
+        0x5bb921eca3ec4c87, 0xac6cac212d56b658, 0x97cd6101cc6cb54e, 0x3047b1f01573d627, \
+        0x87cf0538a0ee87e0, 0x0c1c19a1f83f0d25, 0x75b281ce67c66a32, 0x0891a4a366794b58, \
+        0xb687f0a09c505065, 0x714ac43374dda086, 0xe72025b68c35ece0, 0xf0a62d8365f12e73, \
+        0x896fabb14258ceea, 0x8896a17c020aa2de, 0xaf76ec8e3927dd27, 0xeec50a048ccefd38, \
+        0x7168dc223acf90df, 0x51d1ff9e097b9312, 0xe431cdb4545417a9, 0x71b47a1d0046081a, \
+        0x446931433c185427, 0x05d1b58241c931a0, 0xb5d41488a941463b, 0xff2c013a40675161, \
+        0x419fce0894a18532, 0x3d7543fff8968108, 0x130f173fcbbc8d92, 0xef7b5f4a9f210991, \
+        0x6b4173438557f1ec, 0x9078eb67d4189c77, 0x7d5f97329399ea88, 0xa16730adde13e70f, \
+        0x9b7285985720c6e9, 0x7ba0a3db1c61c76b, 0xd005e4d77e10ccd8, 0x45433db99792998f, \
+        0xe4e054569753b395, 0xe63d902f09eece05, 0x93121ae1d905435a, 0x109156aea58c763e, \
+        0x33ebd4e882b4c4f1, 0x2a467feef4366de0, 0xe8df7bace9bda986, 0x946cf43314448829, \
+        0xa6157064226180a2, 0xc22a26c3f8140cc9, 0x6a1fe1366e096f65, 0x9253f53b6ba315ac, \
+    }, \
+    .castlingKeys = { \
+        0x15f1598496fdad0f, 0xc3a752ef3f7721e1, 0xca0f7b4d8fed6b43, 0xecb338f929789785, \
+        0x93377d9c5be1f377, 0x7dd97549a73dc0ca, 0x54eae1f26e87becb, 0x6e970bf1849ecec2, \
+        0xf16b9ff818fd2173, 0x48ea069458968fd7, 0x28506d9157f62744, 0x021b8694ea8288d8, \
+        0xf94e4ffc997490ac, 0xfe6f508174135a68, 0x85068254bd1dee03, 0x863c740b49ab297c, \
+    }, \
+    .enPassantFileKeys = { \
+        0xf38a104ecf09fe18, 0x9a794aa18b96324a, 0xc7235d860a7b44c0, 0x7424485097571fee, \
+        0x06d9dd56518e1f53, 0xd2f6ff5d5881ee3d, 0x5286475bf956719d, 0x0037e7cbdfd9a026, \
+    }, \
+    .sideToMoveIsBlackKey = 0x14f7f89c6b7961fc \
+}
+
+#endif
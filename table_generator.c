@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "board_constants.h"
+#include "lookup.h"
+#include "magic.h"
+#include "zobrist.h"
+
+// Prints every table the engine used to build at startup as C initializers, so it can ship them as const data instead.
+// Built with RUNTIME_TABLES by `make tables`, usage: table_generator <lookup header> <zobrist header>
+
+enum {
+    values_per_line = 4
+};
+
+static Lookup_t lookup;
+static MagicEntry_t rookEntries[NUM_SQUARES];
+static MagicEntry_t bishopEntries[NUM_SQUARES];
+static Bitboard_t magicAttackTable[NUM_HASH_ENTRIES];
+static Bitboard_t pextAttackTable[NUM_HASH_ENTRIES];
+static ZobristKeys_t zobristKeys;
+
+static void PrintHeaderStart(FILE* file, const char* guard) {
+    fprintf(file, "#ifndef %s\n#define %s\n\n", guard, guard);
+    fprintf(file, "// generated by `make tables`, don't edit by hand\n\n");
+}
+
+static void PrintHeaderEnd(FILE* file) {
+    fprintf(file, "#endif\n");
+}
+
+static void PrintValues(FILE* file, const uint64_t* values, int count, const char* indent) {
+    for(int i = 0; i < count; i++) {
+        if(i % values_per_line == 0) {
+            fprintf(file, "%s", indent);
+        }
+
+        fprintf(file, "0x%016" PRIx64 ",", values[i]);
+
+        bool lineIsFull = (i % values_per_line == values_per_line - 1) || (i == count - 1);
+        fprintf(file, lineIsFull ? " \\\n" : " ");
+    }
+}
+
+static void PrintArray(FILE* file, const char* field, const uint64_t* values, int count) {
+    fprintf(file, "    .%s = { \\\n", field);
+    PrintValues(file, values, count, "        ");
+    fprintf(file, "    }, \\\n");
+}
+
+static void PrintArrayOfRows(FILE* file, const char* field, const uint64_t* values, int numRows, int rowLength) {
+    fprintf(file, "    .%s = { \\\n", field);
+    for(int row = 0; row < numRows; row++) {
+        fprintf(file, "        { \\\n");
+        PrintValues(file, &values[row * rowLength], rowLength, "            ");
+        fprintf(file, "        }, \\\n");
+    }
+    fprintf(file, "    }, \\\n");
+}
+
+static void PrintMagicEntries(FILE* file, const char* field, const MagicEntry_t entries[NUM_SQUARES]) {
+    fprintf(file, "    .%s = { \\\n", field);
+    for(Square_t square = 0; square < NUM_SQUARES; square++) {
+        fprintf(
+            file,
+            "        { 0x%016" PRIx64 ", 0x%016" PRIx64 ", %d, %" PRIu32 " }, \\\n",
+            entries[square].mask,
+            entries[square].magic,
+            entries[square].shift,
+            entries[square].offset
+        );
+    }
+    fprintf(file, "    }, \\\n");
+}
+
+static void PrintSquares(FILE* file, const char* field, const Square_t squares[2]) {
+    fprintf(file, "    .%s = { %d, %d }, \\\n", field, squares[white], squares[black]);
+}
+
+static void PrintAttackTable(FILE* file, const char* name, const Bitboard_t table[NUM_HASH_ENTRIES]) {
+    fprintf(file, "#define %s { \\\n", name);
+    PrintValues(file, table, NUM_HASH_ENTRIES, "    ");
+    fprintf(file, "}\n\n");
+}
+
+static void PrintLookupTables(FILE* file) {
+    PrintHeaderStart(file, "__LOOKUP_TABLES_H__");
+
+    fprintf(file, "#define LOOKUP_TABLES { \\\n");
+    PrintArray(file, "singleBitsets", lookup.singleBitsets, NUM_SQUARES);
+    PrintArray(file, "knightAttacks", lookup.knightAttacks, NUM_SQUARES);
+    PrintArray(file, "kingAttacks", lookup.kingAttacks, NUM_SQUARES);
+    PrintMagicEntries(file, "rookMagicEntries", lookup.rookMagicEntries);
+    PrintMagicEntries(file, "bishopMagicEntries", lookup.bishopMagicEntries);
+    PrintArrayOfRows(file, "slidingCheckmasks", &lookup.slidingCheckmasks[0][0], NUM_SQUARES, NUM_SQUARES);
+    PrintArrayOfRows(file, "pawnCheckmasks", &lookup.pawnCheckmasks[0][0], 2, NUM_SQUARES);
+    PrintArrayOfRows(file, "directionalRays", &lookup.directionalRays[0][0], NUM_SQUARES, NUM_DIRECTIONS);
+    PrintArrayOfRows(file, "passedPawnMasks", &lookup.passedPawnMasks[0][0], 2, NUM_SQUARES);
+    PrintArray(file, "adjacentFileMasks", lookup.adjacentFileMasks, NUM_SQUARES);
+    PrintSquares(file, "ksCastleSquares", lookup.ksCastleSquares);
+    PrintSquares(file, "qsCastleSquares", lookup.qsCastleSquares);
+    fprintf(file, "}\n\n");
+
+    // both backends share the entries above, only the order inside each square's slice differs
+    PrintAttackTable(file, "MAGIC_ATTACK_TABLE", magicAttackTable);
+    PrintAttackTable(file, "PEXT_ATTACK_TABLE", pextAttackTable);
+
+    PrintHeaderEnd(file);
+}
+
+static void PrintZobristKeys(FILE* file) {
+    PrintHeaderStart(file, "__ZOBRIST_KEYS_H__");
+
+    fprintf(file, "#define ZOBRIST_KEYS { \\\n");
+    PrintArray(file, "whitePieceKeys", zobristKeys.whitePieceKeys, NUM_SQUARES * NUM_PIECES);
+    PrintArray(file, "blackPieceKeys", zobristKeys.blackPieceKeys, NUM_SQUARES * NUM_PIECES);
+    PrintArray(file, "castlingKeys", zobristKeys.castlingKeys, 16);
+    PrintArray(file, "enPassantFileKeys", zobristKeys.enPassantFileKeys, 8);
+    fprintf(file, "    .sideToMoveIsBlackKey = 0x%016" PRIx64 " \\\n", zobristKeys.sideToMoveIsBlackKey);
+    fprintf(file, "}\n\n");
+
+    PrintHeaderEnd(file);
+}
+
+static bool WriteHeader(const char* path, void (*PrintCallback)(FILE*)) {
+    FILE* file = fopen(path, "w");
+    if(file == NULL) {
+        fprintf(stderr, "can't open %s\n", path);
+        return false;
+    }
+
+    PrintCallback(file);
+    fclose(file);
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if(argc != 3) {
+        fprintf(stderr, "usage: %s <lookup header> <zobrist header>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // the keys come from a fixed seed, so drawing them first gives the same keys every run
+    BuildZobristKeys(&zobristKeys);
+
+    BuildLookupTables(&lookup);
+    InitAllMagicEntries(rookEntries, bishopEntries, magicAttackTable);
+    InitAllPextEntries(rookEntries, bishopEntries, pextAttackTable);
+
+    bool success =
+        WriteHeader(argv[1], PrintLookupTables) &&
+        WriteHeader(argv[2], PrintZobristKeys);
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -356,10 +356,12 @@ bool BoardIsValid(BoardInfo_t *info, GameStack_t* gameStack) {
         return false;
     }
 
+#ifndef UNDO_UNMAKE
     BoardInfo_t savedInfo = ReadCurrentBoardInfo(gameStack);
     if(!CompareInfo(info, &savedInfo)) {
         return false;
     }
+#endif
 
     return true;
 }
@@ -0,0 +1,112 @@
+#include <stdlib.h>
+
+#include "NNUE_tdd.h"
+#include "game_state.h"
+#include "zobrist.h"
+#include "debug.h"
+#include "FEN.h"
+#include "movegen.h"
+#include "make_and_unmake.h"
+
+static BoardInfo_t boardInfo;
+static GameStack_t gameStack;
+static ZobristStack_t zobristStack;
+static AccumulatorStack_t accumulatorStack;
+static AccumulatorStack_t referenceStack;
+
+static int32_t EvaluateFen(FEN_t fen) {
+    InterpretFEN(fen, &boardInfo, &gameStack, &zobristStack);
+    ClearAccumulatorStack(&accumulatorStack);
+    return NNUEEvaluate(&boardInfo, &gameStack, &accumulatorStack);
+}
+
+// throws away everything the reference stack knows about this line, so it has to start over from the board
+static int32_t EvaluateFromScratch() {
+    for(int i = 0; i <= gameStack.top; i++) {
+        referenceStack.accumulators[i].hash = 0;
+    }
+
+    return NNUEEvaluate(&boardInfo, &gameStack, &referenceStack);
+}
+
+// only the leaves get evaluated, so every update replays a few plies of dirty pieces at once
+static bool IncrementalEvalMatchesRefresh(int depth) {
+    if(depth == 0) {
+        return NNUEEvaluate(&boardInfo, &gameStack, &accumulatorStack) == EvaluateFromScratch();
+    }
+
+    bool matches = true;
+
+    MoveList_t moveList;
+    CompleteMovegen(&moveList, &boardInfo, &gameStack);
+    for(int i = 0; i <= moveList.maxIndex; i++) {
+        MakeMove(&boardInfo, &gameStack, moveList.moves[i]);
+        matches = matches && IncrementalEvalMatchesRefresh(depth - 1);
+        UnmakeMove(&boardInfo, &gameStack);
+    }
+
+    // not recursing past it, a null move out of check would let the king be taken
+    MakeNullMove(&boardInfo, &gameStack);
+    matches = matches && IncrementalEvalMatchesRefresh(0);
+    UnmakeNullMove(&boardInfo, &gameStack);
+
+    return matches;
+}
+
+// TESTS
+static void ShouldMatchFullRefreshAfterIncrementalUpdates() {
+    FEN_t fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbqkb1r/pp1p1ppp/5n2/2pPp3/8/8/PPP1PPPP/RNBQKBNR w KQkq c6 0 4",
+    };
+
+    bool success = true;
+    for(int i = 0; i < 4; i++) {
+        EvaluateFen(fens[i]);
+        success = success && IncrementalEvalMatchesRefresh(3);
+    }
+
+    PrintResults(success);
+}
+
+static void ShouldScoreSymmetricPositionsAsEven() {
+    PrintResults(
+        EvaluateFen(START_FEN) == 0 &&
+        EvaluateFen("r3k2r/pp3ppp/2n1b3/8/8/2N1B3/PP3PPP/R3K2R b KQkq - 0 1") == 0
+    );
+}
+
+static void ShouldScoreFromSideToMove() {
+    int32_t whiteToMove = EvaluateFen("4k3/8/8/8/8/8/8/3QK3 w - - 0 1");
+    int32_t blackToMove = EvaluateFen("4k3/8/8/8/8/8/8/3QK3 b - - 0 1");
+
+    PrintResults(whiteToMove == -blackToMove);
+}
+
+// the embedded network is the midgame material + PST eval, rounded to 8 centipawns a piece
+static void EmbeddedNetworkShouldCountMaterial() {
+    int32_t upAQueen = EvaluateFen("4k3/8/8/8/8/8/8/3QK3 w - - 0 1");
+    int32_t upAKnight = EvaluateFen("rnbqkb1r/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+
+    PrintResults(abs(upAQueen - 895) <= 10 && abs(upAKnight - 270) <= 10);
+}
+
+static void ShouldKeepNetworkWhenFileIsMissing() {
+    int32_t before = EvaluateFen("4k3/8/8/8/8/8/8/3QK3 w - - 0 1");
+    bool loaded = NNUELoadNetwork("this/network/does/not/exist.nnue");
+    int32_t after = EvaluateFen("4k3/8/8/8/8/8/8/3QK3 w - - 0 1");
+
+    PrintResults(!loaded && before == after);
+}
+
+void NNUETDDRunner() {
+    NNUEUseEmbeddedNetwork();
+
+    ShouldMatchFullRefreshAfterIncrementalUpdates();
+    ShouldScoreSymmetricPositionsAsEven();
+    ShouldScoreFromSideToMove();
+    EmbeddedNetworkShouldCountMaterial();
+    ShouldKeepNetworkWhenFileIsMissing();
+}
@@ -0,0 +1,8 @@
+#ifndef __NNUE_TDD_H__
+#define __NNUE_TDD_H__
+
+#include "NNUE.h"
+
+void NNUETDDRunner();
+
+#endif
@@ -0,0 +1,74 @@
+#include "SEE_tdd.h"
+#include "game_state.h"
+#include "zobrist.h"
+#include "debug.h"
+#include "FEN.h"
+
+static BoardInfo_t boardInfo;
+static GameStack_t gameStack;
+static ZobristStack_t zobristStack;
+
+static Move_t CreateMove(Square_t from, Square_t to) {
+    Move_t move;
+    InitMove(&move);
+    WriteFromSquare(&move, from);
+    WriteToSquare(&move, to);
+    return move;
+}
+
+static bool SEEMatches(FEN_t fen, Move_t move, EvalScore_t expected) {
+    InterpretFEN(fen, &boardInfo, &gameStack, &zobristStack);
+
+    return
+        SEEValue(&boardInfo, move) == expected &&
+        SEEPassesThreshold(&boardInfo, move, expected) &&
+        !SEEPassesThreshold(&boardInfo, move, expected + 1);
+}
+
+static void ShouldWinUndefendedPawn() {
+    FEN_t fen = "1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1";
+    PrintResults(SEEMatches(fen, CreateMove(e1, e5), pawn_value));
+}
+
+static void ShouldLoseQueenForDefendedPawn() {
+    FEN_t fen = "4k3/8/3p4/4p3/8/8/8/4Q1K1 w - - 0 1";
+    PrintResults(SEEMatches(fen, CreateMove(e1, e5), pawn_value - queen_value));
+}
+
+// the black queen only joins in once the bishop in front of it has recaptured
+static void ShouldCountXRayAttackers() {
+    FEN_t fen = "1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1";
+    PrintResults(SEEMatches(fen, CreateMove(d3, e5), pawn_value - knight_value));
+}
+
+static void KingShouldNotRecaptureIntoDefendedSquare() {
+    FEN_t fen = "8/8/3k4/4p3/8/8/4R3/4R1K1 w - - 0 1";
+    PrintResults(SEEMatches(fen, CreateMove(e2, e5), pawn_value));
+}
+
+static void ShouldEvaluateEnPassant() {
+    FEN_t fen = "4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1";
+    Move_t enPassant = CreateMove(e5, d6);
+    WriteSpecialFlag(&enPassant, en_passant_flag);
+
+    PrintResults(SEEMatches(fen, enPassant, pawn_value));
+}
+
+// the black queen could take the new queen on b8, but the rook behind the pawn would take it back
+static void ShouldCreditQueenPromotionOntoDefendedSquare() {
+    FEN_t fen = "7q/1P6/8/8/7k/8/8/1R2K3 w - - 0 1";
+    Move_t promotion = CreateMove(b7, b8);
+    WritePromotionPiece(&promotion, queen);
+    WriteSpecialFlag(&promotion, promotion_flag);
+
+    PrintResults(SEEMatches(fen, promotion, queen_value - pawn_value));
+}
+
+void SEETDDRunner() {
+    ShouldWinUndefendedPawn();
+    ShouldLoseQueenForDefendedPawn();
+    ShouldCountXRayAttackers();
+    KingShouldNotRecaptureIntoDefendedSquare();
+    ShouldEvaluateEnPassant();
+    ShouldCreditQueenPromotionOntoDefendedSquare();
+}
@@ -0,0 +1,8 @@
+#ifndef __SEE_TDD_H__
+#define __SEE_TDD_H__
+
+#include "SEE.h"
+
+void SEETDDRunner();
+
+#endif
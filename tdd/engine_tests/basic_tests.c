@@ -1,17 +1,21 @@
 #include "basic_tests.h"
 #include "debug.h"
-#include "fen.h"
+#include "FEN.h"
 #include "board_info.h"
 #include "game_state.h"
 #include "zobrist.h"
 #include "UCI.h"
+#include "transposition_table.h"
+#include "movegen.h"
 
 static BoardInfo_t boardInfo;
 static GameStack_t gameStack;
 static ZobristStack_t zobristStack;
 
 enum {
-    large_time = 100000
+    large_time = 100000,
+    some_node_limit = 20000,
+    node_limit_slack = PLY_MAX // a few nodes get counted while the search unwinds
 };
 
 static UciSearchInfo_t GetUciSearchInfo() {
@@ -37,6 +41,84 @@ static void ShouldFindM2() {
     PrintResults(CompareMoves(results.bestMove, expectedBestMove));
 }
 
+// the extra lines are searched after the first one, so they can't change the best move
+static void ShouldFindM2WithMultiPV() {
+    FEN_t fen = "r7/4n2p/1p4p1/6P1/2k2P2/1q6/7K/8 b - - 25 68";
+    InterpretFEN(fen, &boardInfo, &gameStack, &zobristStack);
+
+    UciSearchInfo_t uciSearchInfo = GetUciSearchInfo();
+    uciSearchInfo.multiPv = 3;
+    SearchResults_t results = Search(&uciSearchInfo, &boardInfo, &gameStack, &zobristStack, false);
+
+    Move_t expectedBestMove;
+    UCITranslateMove(&expectedBestMove, "a8a2", &boardInfo, &gameStack);
+
+    PrintResults(CompareMoves(results.bestMove, expectedBestMove));
+}
+
+// Philidor's smothered mate is all checks, so the check extension has to see all 7 plies of it from depth 3
+static void ShouldFindSmotheredMateThroughChecks() {
+    FEN_t fen = "r6k/6pp/8/6N1/2Q5/8/PPP5/6K1 w - - 0 1";
+    InterpretFEN(fen, &boardInfo, &gameStack, &zobristStack);
+    TTClear();
+
+    UciSearchInfo_t uciSearchInfo = GetUciSearchInfo();
+    uciSearchInfo.depthLimit = 3;
+    SearchResults_t results = Search(&uciSearchInfo, &boardInfo, &gameStack, &zobristStack, false);
+
+    Move_t expectedBestMove;
+    UCITranslateMove(&expectedBestMove, "g5f7", &boardInfo, &gameStack);
+
+    PrintResults(CompareMoves(results.bestMove, expectedBestMove) && results.score == EVAL_MAX - 7);
+}
+
+static SearchResults_t NodeLimitedSearch(FEN_t fen) {
+    InterpretFEN(fen, &boardInfo, &gameStack, &zobristStack);
+    TTClear();
+
+    UciSearchInfo_t uciSearchInfo;
+    UciSearchInfoInit(&uciSearchInfo);
+    uciSearchInfo.nodeLimit = some_node_limit;
+
+    return Search(&uciSearchInfo, &boardInfo, &gameStack, &zobristStack, false);
+}
+
+// no clock is involved, so the same search has to come out the same every time
+static void NodeLimitedSearchShouldBeDeterministic() {
+    FEN_t fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+    SearchResults_t first = NodeLimitedSearch(fen);
+    SearchResults_t second = NodeLimitedSearch(fen);
+
+    PrintResults(
+        first.nodeCount >= some_node_limit &&
+        first.nodeCount < some_node_limit + node_limit_slack &&
+        first.nodeCount == second.nodeCount &&
+        first.score == second.score &&
+        CompareMoves(first.bestMove, second.bestMove)
+    );
+}
+
+// a stop that's already there when the search starts is one that came in before depth 1 finished
+static void StopBeforeFirstIterationShouldStillGiveLegalMove() {
+    InterpretFEN(START_FEN, &boardInfo, &gameStack, &zobristStack);
+
+    UciSearchInfo_t uciSearchInfo = GetUciSearchInfo();
+    atomic_store(&uciSearchInfo.stopSignal, true);
+    SearchResults_t results = Search(&uciSearchInfo, &boardInfo, &gameStack, &zobristStack, false);
+
+    MovegenInfo_t movegenInfo;
+    DefineMovegenInfo(&movegenInfo, &boardInfo);
+
+    PrintResults(
+        results.bestMove.data != 0 &&
+        MoveIsLegal(&boardInfo, &gameStack, &movegenInfo, results.bestMove)
+    );
+}
+
 void BasicTestsRunner() {
     ShouldFindM2();
+    ShouldFindM2WithMultiPV();
+    ShouldFindSmotheredMateThroughChecks();
+    NodeLimitedSearchShouldBeDeterministic();
+    StopBeforeFirstIterationShouldStillGiveLegalMove();
 }
\ No newline at end of file
@@ -9,6 +9,27 @@ static MoveList_t moveList;
 static BoardInfo_t boardInfo;
 static GameStack_t gameStack;
 static ZobristStack_t zobristStack;
+static MoveOrderingInfo_t orderingInfo;
+static SearchStackEntry_t searchStack[PLY_MAX];
+
+enum {
+    some_history_bonus = 1000
+};
+
+static Move_t CreateQuietMove(Square_t from, Square_t to) {
+    Move_t move;
+    InitMove(&move);
+    WriteFromSquare(&move, from);
+    WriteToSquare(&move, to);
+    return move;
+}
+
+// picking every move in turn leaves them sorted, like the search would see them
+static void PickAllMoves(int firstIndex, int lastIndex) {
+    for(int i = firstIndex; i <= lastIndex; i++) {
+        PickNextMove(&moveList, i, lastIndex);
+    }
+}
 
 static EvalScore_t MVVScore(Move_t capture) {
     Square_t toSquare = ReadToSquare(capture);
@@ -38,11 +59,104 @@ static void ShouldOrderCaptures() {
     FEN_t manyCapturesFen = "rnb1kb1r/p4ppp/2p5/4N3/1ppqP1n1/2P1BQ1P/PP3PP1/RN2K2R w KQkq - 2 10";
     InterpretFEN(manyCapturesFen, &boardInfo, &gameStack, &zobristStack);
     CompleteMovegen(&moveList, &boardInfo, &gameStack);
-    SortMoveList(&moveList, &boardInfo);
+    ScoreCaptures(&moveList, &boardInfo);
+    PickAllMoves(0, moveList.maxCapturesIndex);
 
     PrintResults(CapturesAreCorrectlyOrdered());
 }
 
+static void ShouldOrderKillersThenHistory() {
+    InterpretFEN(START_FEN, &boardInfo, &gameStack, &zobristStack);
+    CompleteMovegen(&moveList, &boardInfo, &gameStack);
+    InitMoveOrderingInfo(&orderingInfo);
+
+    Move_t firstKiller = CreateQuietMove(b1, c3);
+    Move_t secondKiller = CreateQuietMove(g1, f3);
+    AddKillerMove(&orderingInfo, secondKiller, 0);
+    AddKillerMove(&orderingInfo, firstKiller, 0);
+
+    Move_t bestHistory = CreateQuietMove(e2, e4);
+    Move_t nextBestHistory = CreateQuietMove(d2, d4);
+    UpdateHistory(&orderingInfo, white, bestHistory, 2*some_history_bonus);
+    UpdateHistory(&orderingInfo, white, nextBestHistory, some_history_bonus);
+
+    ScoreQuiets(&moveList, &boardInfo, &orderingInfo, searchStack, 0);
+    PickAllMoves(moveList.maxCapturesIndex + 1, moveList.maxIndex);
+
+    PrintResults(
+        SameMove(moveList.moves[0], firstKiller) &&
+        SameMove(moveList.moves[1], secondKiller) &&
+        SameMove(moveList.moves[2], bestHistory) &&
+        SameMove(moveList.moves[3], nextBestHistory)
+    );
+}
+
+static void HistoryShouldStayBounded() {
+    InitMoveOrderingInfo(&orderingInfo);
+    Move_t move = CreateQuietMove(e2, e4);
+
+    bool bounded = true;
+    for(int i = 0; i < 1000; i++) {
+        UpdateHistory(&orderingInfo, white, move, some_history_bonus);
+        bounded = bounded && ReadHistory(&orderingInfo, white, move) <= history_max;
+    }
+
+    for(int i = 0; i < 1000; i++) {
+        UpdateHistory(&orderingInfo, white, move, -some_history_bonus);
+        bounded = bounded && ReadHistory(&orderingInfo, white, move) >= -history_max;
+    }
+
+    PrintResults(bounded && ReadHistory(&orderingInfo, black, move) == 0);
+}
+
+static void ShouldOrderCounterMoveBeforeHistory() {
+    InterpretFEN("rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq e6 0 2", &boardInfo, &gameStack, &zobristStack);
+    CompleteMovegen(&moveList, &boardInfo, &gameStack);
+    InitMoveOrderingInfo(&orderingInfo);
+
+    searchStack[0] = (SearchStackEntry_t){ pawn, e5 };
+    Move_t counterMove = CreateQuietMove(g1, f3);
+    SetCounterMove(&orderingInfo, white, searchStack, 1, counterMove);
+
+    Move_t bestHistory = CreateQuietMove(d2, d4);
+    UpdateHistory(&orderingInfo, white, bestHistory, some_history_bonus);
+
+    ScoreQuiets(&moveList, &boardInfo, &orderingInfo, searchStack, 1);
+    PickAllMoves(moveList.maxCapturesIndex + 1, moveList.maxIndex);
+
+    PrintResults(
+        SameMove(moveList.moves[0], counterMove) &&
+        SameMove(moveList.moves[1], bestHistory)
+    );
+}
+
+static void ContinuationHistoryShouldDependOnPreviousMove() {
+    InterpretFEN("rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq e6 0 2", &boardInfo, &gameStack, &zobristStack);
+    InitMoveOrderingInfo(&orderingInfo);
+    Move_t move = CreateQuietMove(g1, f3);
+
+    searchStack[0] = (SearchStackEntry_t){ pawn, e5 };
+    UpdateQuietHistory(&orderingInfo, &boardInfo, searchStack, 1, move, some_history_bonus);
+    HistoryScore_t afterE5 = ReadQuietHistory(&orderingInfo, &boardInfo, searchStack, 1, move);
+
+    searchStack[0] = (SearchStackEntry_t){ pawn, d5 };
+    HistoryScore_t afterD5 = ReadQuietHistory(&orderingInfo, &boardInfo, searchStack, 1, move);
+
+    // after a null move only the butterfly history is left
+    searchStack[0] = (SearchStackEntry_t){ none_type, e5 };
+    HistoryScore_t afterNullMove = ReadQuietHistory(&orderingInfo, &boardInfo, searchStack, 1, move);
+
+    PrintResults(
+        afterE5 == 2*some_history_bonus &&
+        afterD5 == some_history_bonus &&
+        afterNullMove == ReadHistory(&orderingInfo, white, move)
+    );
+}
+
 void MoveOrderingTDDRunner() {
     ShouldOrderCaptures();
+    ShouldOrderKillersThenHistory();
+    HistoryShouldStayBounded();
+    ShouldOrderCounterMoveBeforeHistory();
+    ContinuationHistoryShouldDependOnPreviousMove();
 }
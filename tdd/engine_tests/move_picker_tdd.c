@@ -0,0 +1,156 @@
+#include "move_picker_tdd.h"
+#include "game_state.h"
+#include "zobrist.h"
+#include "debug.h"
+#include "FEN.h"
+#include "util_macros.h"
+
+static BoardInfo_t boardInfo;
+static GameStack_t gameStack;
+static ZobristStack_t zobristStack;
+static MoveOrderingInfo_t orderingInfo;
+static SearchStackEntry_t searchStack[PLY_MAX];
+
+static FEN_t testPositions[] = {
+    START_FEN,
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "rnbqkbnr/ppp2ppp/8/3pp3/4P3/5Q2/PPPP1PPP/RNB1KBNR w KQkq d6 0 3",
+    "4k3/8/8/8/8/8/3q4/4K3 w - - 0 1",
+    "rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3",
+};
+
+static Move_t CreateMove(Square_t from, Square_t to) {
+    Move_t move;
+    InitMove(&move);
+    WriteFromSquare(&move, from);
+    WriteToSquare(&move, to);
+    return move;
+}
+
+static int CountInList(MoveList_t* moveList, Move_t move) {
+    int count = 0;
+    for(int i = 0; i <= moveList->maxIndex; i++) {
+        count += SameMove(moveList->moves[i], move);
+    }
+
+    return count;
+}
+
+// in check the evasions can be counted first, the picker then has to hand out that same list
+static bool PicksEveryLegalMoveOnce(Move_t ttMove, bool countEvasions) {
+    MoveList_t legalMoves;
+    CompleteMovegen(&legalMoves, &boardInfo, &gameStack);
+
+    MovePicker_t picker;
+    InitMovePicker(&picker, &boardInfo, &gameStack, &orderingInfo, searchStack, ttMove, 0);
+
+    if(countEvasions && picker.movegenInfo.inCheck && CountEvasions(&picker) != legalMoves.maxIndex + 1) {
+        return false;
+    }
+
+    MoveList_t pickedMoves;
+    pickedMoves.maxIndex = movelist_empty;
+    Move_t move;
+    while(NextMove(&picker, &move)) {
+        pickedMoves.maxIndex++;
+        pickedMoves.moves[pickedMoves.maxIndex] = move;
+    }
+
+    if(pickedMoves.maxIndex != legalMoves.maxIndex) {
+        return false;
+    }
+
+    for(int i = 0; i <= legalMoves.maxIndex; i++) {
+        if(CountInList(&pickedMoves, legalMoves.moves[i]) != 1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void ShouldPickEveryLegalMoveOnce() {
+    bool success = true;
+    for(int i = 0; i < NUM_ARRAY_ELEMENTS(testPositions); i++) {
+        InterpretFEN(testPositions[i], &boardInfo, &gameStack, &zobristStack);
+        InitMoveOrderingInfo(&orderingInfo);
+
+        MoveList_t legalMoves;
+        CompleteMovegen(&legalMoves, &boardInfo, &gameStack);
+
+        // one killer that is usually legal, one that is never legal
+        AddKillerMove(&orderingInfo, CreateMove(a8, a1), 0);
+        AddKillerMove(&orderingInfo, legalMoves.moves[legalMoves.maxIndex], 0);
+
+        Move_t noTTMove;
+        InitMove(&noTTMove);
+        Move_t illegalTTMove = CreateMove(h1, a8);
+        Move_t legalTTMove = legalMoves.moves[legalMoves.maxIndex / 2];
+
+        success = success &&
+            PicksEveryLegalMoveOnce(noTTMove, false) &&
+            PicksEveryLegalMoveOnce(illegalTTMove, false) &&
+            PicksEveryLegalMoveOnce(legalTTMove, false) &&
+            PicksEveryLegalMoveOnce(noTTMove, true) &&
+            PicksEveryLegalMoveOnce(legalTTMove, true);
+    }
+
+    PrintResults(success);
+}
+
+static void ShouldPickTTMoveFirst() {
+    InterpretFEN(testPositions[1], &boardInfo, &gameStack, &zobristStack);
+    InitMoveOrderingInfo(&orderingInfo);
+
+    Move_t ttMove = CreateMove(a2, a3);
+    MovePicker_t picker;
+    InitMovePicker(&picker, &boardInfo, &gameStack, &orderingInfo, searchStack, ttMove, 0);
+
+    Move_t firstMove;
+    PrintResults(NextMove(&picker, &firstMove) && SameMove(firstMove, ttMove));
+}
+
+static void CapturePickerShouldOnlyPickCaptures() {
+    InterpretFEN(testPositions[1], &boardInfo, &gameStack, &zobristStack);
+
+    MovePicker_t picker;
+    InitCapturePicker(&picker, &boardInfo, &gameStack, false);
+
+    int numCaptures = 0;
+    bool onlyCaptures = true;
+    Move_t move;
+    while(NextMove(&picker, &move)) {
+        numCaptures++;
+        bool isCapture =
+            PieceOnSquare(&boardInfo, ReadToSquare(move)) != none_type ||
+            ReadSpecialFlag(move) == en_passant_flag;
+        onlyCaptures = onlyCaptures && isCapture;
+    }
+
+    int kiwipeteCaptures = 8;
+    PrintResults(onlyCaptures && numCaptures == kiwipeteCaptures);
+}
+
+static void ShouldRejectIllegalMoves() {
+    FEN_t pinnedKnightFen = "4k3/4n3/8/8/8/8/8/4R1K1 b - - 0 1";
+    InterpretFEN(pinnedKnightFen, &boardInfo, &gameStack, &zobristStack);
+
+    MovegenInfo_t movegenInfo;
+    DefineMovegenInfo(&movegenInfo, &boardInfo);
+
+    bool success =
+        !MoveIsLegal(&boardInfo, &gameStack, &movegenInfo, CreateMove(e7, c6)) && // pinned
+        !MoveIsLegal(&boardInfo, &gameStack, &movegenInfo, CreateMove(e1, e2)) && // not our piece
+        !MoveIsLegal(&boardInfo, &gameStack, &movegenInfo, CreateMove(e8, e6)) && // not how a king moves
+        MoveIsLegal(&boardInfo, &gameStack, &movegenInfo, CreateMove(e8, d8));
+
+    PrintResults(success);
+}
+
+void MovePickerTDDRunner() {
+    ShouldPickEveryLegalMoveOnce();
+    ShouldPickTTMoveFirst();
+    CapturePickerShouldOnlyPickCaptures();
+    ShouldRejectIllegalMoves();
+}
@@ -0,0 +1,8 @@
+#ifndef __MOVE_PICKER_TDD_H__
+#define __MOVE_PICKER_TDD_H__
+
+#include "move_picker.h"
+
+void MovePickerTDDRunner();
+
+#endif
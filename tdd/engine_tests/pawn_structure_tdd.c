@@ -0,0 +1,66 @@
+#include "pawn_structure_tdd.h"
+#include "game_state.h"
+#include "zobrist.h"
+#include "debug.h"
+#include "FEN.h"
+
+static BoardInfo_t boardInfo;
+static GameStack_t gameStack;
+static ZobristStack_t zobristStack;
+static PawnTable_t pawnTable;
+
+static PackedScore_t ScoreOfFen(FEN_t fen) {
+    InterpretFEN(fen, &boardInfo, &gameStack, &zobristStack);
+    return PawnStructureScore(&pawnTable, &boardInfo, ReadPawnHash(&gameStack));
+}
+
+static void ShouldScoreMirroredStructuresAsEven() {
+    ClearPawnTable(&pawnTable);
+    PrintResults(
+        ScoreOfFen(START_FEN) == 0 &&
+        ScoreOfFen("4k3/pp3p1p/2p3p1/8/8/2P3P1/PP3P1P/4K3 w - - 0 1") == 0
+    );
+}
+
+static void ShouldRewardPassedPawns() {
+    ClearPawnTable(&pawnTable);
+    PackedScore_t whitePasser = ScoreOfFen("4k3/8/8/3P4/8/8/8/4K3 w - - 0 1");
+    PackedScore_t blackPasser = ScoreOfFen("4k3/8/8/8/3p4/8/8/4K3 w - - 0 1");
+
+    PrintResults(whitePasser > 0 && blackPasser == -whitePasser);
+}
+
+static void ShouldPenalizeDoubledIsolatedPawns() {
+    ClearPawnTable(&pawnTable);
+    PackedScore_t doubled = ScoreOfFen("4k3/2p5/8/8/8/2P5/2P5/4K3 w - - 0 1");
+    PackedScore_t connected = ScoreOfFen("4k3/2p5/8/8/8/2P5/3P4/4K3 w - - 0 1");
+
+    PrintResults(doubled < connected);
+}
+
+static void ShouldPenalizeBackwardPawns() {
+    ClearPawnTable(&pawnTable);
+    // d3 can't step up without being taken by c5, and the e4 pawn is already past it. From d2 it isn't stuck yet
+    PackedScore_t backward = ScoreOfFen("4k3/8/8/2p5/4P3/3P4/8/4K3 w - - 0 1");
+    PackedScore_t notBackward = ScoreOfFen("4k3/8/8/2p5/4P3/8/3P4/4K3 w - - 0 1");
+
+    PrintResults(backward < notBackward);
+}
+
+// same pawns, so the second probe hits the cached entry, but the shield has to follow the king
+static void ShouldRecomputeShieldWhenKingMoves() {
+    ClearPawnTable(&pawnTable);
+    PackedScore_t castled = ScoreOfFen("6k1/5ppp/8/8/8/8/5PPP/6K1 w - - 0 1");
+    PackedScore_t castledAgain = ScoreOfFen("6k1/5ppp/8/8/8/8/5PPP/6K1 w - - 0 1");
+    PackedScore_t exposed = ScoreOfFen("6k1/5ppp/8/8/8/8/5PPP/K7 w - - 0 1");
+
+    PrintResults(castled == 0 && castledAgain == castled && exposed < castled);
+}
+
+void PawnStructureTDDRunner() {
+    ShouldScoreMirroredStructuresAsEven();
+    ShouldRewardPassedPawns();
+    ShouldPenalizeDoubledIsolatedPawns();
+    ShouldPenalizeBackwardPawns();
+    ShouldRecomputeShieldWhenKingMoves();
+}
@@ -0,0 +1,8 @@
+#ifndef __PAWN_STRUCTURE_TDD_H__
+#define __PAWN_STRUCTURE_TDD_H__
+
+#include "pawn_structure.h"
+
+void PawnStructureTDDRunner();
+
+#endif
@@ -0,0 +1,91 @@
+#include "transposition_table_tdd.h"
+#include "debug.h"
+
+// too wide for an enum constant
+static const ZobristHash_t some_hash = 0x123456789abcdef;
+static const ZobristHash_t some_other_hash = 0xfedcba987654321;
+
+enum {
+    some_score = 57,
+    some_depth = 6
+};
+
+static Move_t SomeMove() {
+    Move_t move;
+    InitMove(&move);
+    WriteFromSquare(&move, e2);
+    WriteToSquare(&move, e4);
+    return move;
+}
+
+static void ShouldRetrieveStoredEntry() {
+    TTClear();
+    TTStore(some_hash, SomeMove(), some_score, some_depth, exact_bound);
+
+    TTEntry_t entry;
+    bool success = 
+        TTProbe(some_hash, &entry) &&
+        entry.score == some_score &&
+        entry.depth == some_depth &&
+        entry.bound == exact_bound &&
+        CompareMoves(entry.bestMove, SomeMove());
+
+    PrintResults(success);
+}
+
+static void ShouldMissUnstoredPosition() {
+    TTClear();
+    TTStore(some_hash, SomeMove(), some_score, some_depth, exact_bound);
+
+    TTEntry_t entry;
+    PrintResults(!TTProbe(some_other_hash, &entry));
+}
+
+static void ShouldKeepBestMoveOnFailLow() {
+    TTClear();
+    TTStore(some_hash, SomeMove(), some_score, some_depth, lower_bound);
+
+    Move_t noMove;
+    InitMove(&noMove);
+    TTStore(some_hash, noMove, -some_score, some_depth, upper_bound);
+
+    TTEntry_t entry;
+    bool success = 
+        TTProbe(some_hash, &entry) &&
+        entry.bound == upper_bound &&
+        CompareMoves(entry.bestMove, SomeMove());
+
+    PrintResults(success);
+}
+
+static void ShouldNotOverwriteDeeperBoundWithShallowBound() {
+    TTClear();
+    TTStore(some_hash, SomeMove(), some_score, some_depth, lower_bound);
+    TTStore(some_hash, SomeMove(), -some_score, 1, upper_bound);
+
+    TTEntry_t entry;
+    bool success = 
+        TTProbe(some_hash, &entry) &&
+        entry.depth == some_depth &&
+        entry.score == some_score;
+
+    PrintResults(success);
+}
+
+static void ShouldForgetEverythingAfterResize() {
+    TTStore(some_hash, SomeMove(), some_score, some_depth, exact_bound);
+    TTResize(hash_min_mb);
+
+    TTEntry_t entry;
+    PrintResults(!TTProbe(some_hash, &entry));
+
+    TTResize(hash_default_mb);
+}
+
+void TranspositionTableTDDRunner() {
+    ShouldRetrieveStoredEntry();
+    ShouldMissUnstoredPosition();
+    ShouldKeepBestMoveOnFailLow();
+    ShouldNotOverwriteDeeperBoundWithShallowBound();
+    ShouldForgetEverythingAfterResize();
+}
\ No newline at end of file
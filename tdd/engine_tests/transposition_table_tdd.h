@@ -0,0 +1,8 @@
+#ifndef __TRANSPOSITION_TABLE_TDD_H__
+#define __TRANSPOSITION_TABLE_TDD_H__
+
+#include "transposition_table.h"
+
+void TranspositionTableTDDRunner();
+
+#endif
\ No newline at end of file
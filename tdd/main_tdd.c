@@ -17,10 +17,18 @@
 #include "zobrist_tdd.h"
 #include "endings_tdd.h"
 #include "UCI.h"
+#include "transposition_table.h"
+#include "NNUE.h"
+#include "chess_search.h"
 #include "basic_tests.h"
 #include "PV_table_tdd.h"
 #include "random_crashes.h"
 #include "move_ordering_tdd.h"
+#include "move_picker_tdd.h"
+#include "SEE_tdd.h"
+#include "pawn_structure_tdd.h"
+#include "NNUE_tdd.h"
+#include "transposition_table_tdd.h"
 
 int main(int argc, char** argv)
 {
@@ -28,6 +36,9 @@ int main(int argc, char** argv)
 
     InitLookupTables();
     GenerateZobristKeys();
+    NNUEInit();
+    TTInit();
+    InitSearchTables();
 
     LookupTDDRunner();
     BitboardsTDDRunner();
@@ -47,6 +58,11 @@ int main(int argc, char** argv)
     BasicTestsRunner();
     PvTableTDDRunner();
     MoveOrderingTDDRunner();
+    MovePickerTDDRunner();
+    SEETDDRunner();
+    PawnStructureTDDRunner();
+    NNUETDDRunner();
+    TranspositionTableTDDRunner();
 
     // RANDOM CRASHES
     RandomCrashTestRunner(false);
@@ -60,7 +76,7 @@ int main(int argc, char** argv)
     RunAllPerftTests(false);
     
     UciApplicationData_t uciApplicationData;
-    UciSearchInfoInit(&uciApplicationData.uciSearchInfo);
+    UciApplicationDataInit(&uciApplicationData);
     bool running = !false;
     while(running)
     {
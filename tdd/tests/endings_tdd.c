@@ -37,7 +37,7 @@ static bool GameEndStatusShouldBe(
 static void MakeMoveAndAddHash(Move_t move) {
     MakeMove(&boardInfo, &gameStack, move);
 
-    AddZobristHashToStack(&zobristStack, HashPosition(&boardInfo, &gameStack));
+    AddZobristHashToStack(&zobristStack, ReadZobristHash(&gameStack));
 }
 
 // TESTS
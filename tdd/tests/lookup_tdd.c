@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "debug.h"
 #include "lookup_tdd.h"
@@ -46,6 +47,61 @@ static void ShouldCorrectlyFindDirectionalRays() {
     PrintResults(GetDirectionalRay(square, SE) == expectedRay);
 }
 
+static void ShouldFindPassedPawnMasks() {
+    Bitboard_t expectedWhiteMask = CreateBitboard(6, a7,b7,c7,a8,b8,c8);
+    Bitboard_t expectedBlackMask = CreateBitboard(2, g1,h1);
+
+    PrintResults(
+        GetPassedPawnMask(b6, white) == expectedWhiteMask &&
+        GetPassedPawnMask(h2, black) == expectedBlackMask
+    );
+}
+
+static void ShouldFindAdjacentFileMasks() {
+    PrintResults(
+        GetAdjacentFileMask(a4) == (a_file << 1) &&
+        GetAdjacentFileMask(e2) == (d_file | (d_file << 2))
+    );
+}
+
+static bool SameMagicEntries(const MagicEntry_t a[NUM_SQUARES], const MagicEntry_t b[NUM_SQUARES]) {
+    for(Square_t square = 0; square < NUM_SQUARES; square++) {
+        if(
+            a[square].mask != b[square].mask ||
+            a[square].magic != b[square].magic ||
+            a[square].shift != b[square].shift ||
+            a[square].offset != b[square].offset
+        )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// the compiled in tables go stale if a table changes without rerunning `make tables`
+static void GeneratedTablesShouldMatchFreshlyBuiltOnes() {
+    static Lookup_t fresh;
+    BuildLookupTables(&fresh);
+    const Lookup_t* current = ReadLookupTables();
+
+    PrintResults(
+        !memcmp(fresh.singleBitsets, current->singleBitsets, sizeof(fresh.singleBitsets)) &&
+        !memcmp(fresh.knightAttacks, current->knightAttacks, sizeof(fresh.knightAttacks)) &&
+        !memcmp(fresh.kingAttacks, current->kingAttacks, sizeof(fresh.kingAttacks)) &&
+        SameMagicEntries(fresh.rookMagicEntries, current->rookMagicEntries) &&
+        SameMagicEntries(fresh.bishopMagicEntries, current->bishopMagicEntries) &&
+        !memcmp(fresh.slidingCheckmasks, current->slidingCheckmasks, sizeof(fresh.slidingCheckmasks)) &&
+        !memcmp(fresh.pawnCheckmasks, current->pawnCheckmasks, sizeof(fresh.pawnCheckmasks)) &&
+        !memcmp(fresh.directionalRays, current->directionalRays, sizeof(fresh.directionalRays)) &&
+        !memcmp(fresh.passedPawnMasks, current->passedPawnMasks, sizeof(fresh.passedPawnMasks)) &&
+        !memcmp(fresh.adjacentFileMasks, current->adjacentFileMasks, sizeof(fresh.adjacentFileMasks)) &&
+        !memcmp(fresh.ksCastleSquares, current->ksCastleSquares, sizeof(fresh.ksCastleSquares)) &&
+        !memcmp(fresh.qsCastleSquares, current->qsCastleSquares, sizeof(fresh.qsCastleSquares))
+    );
+}
+
 void LookupTDDRunner() {
     ShouldInitializeSingleBitset();
     // Just pretend there are more tests here
@@ -53,4 +109,9 @@ void LookupTDDRunner() {
     ShouldGetOtherSlidingCheckmaskLookup();
 
     ShouldCorrectlyFindDirectionalRays();
+
+    ShouldFindPassedPawnMasks();
+    ShouldFindAdjacentFileMasks();
+
+    GeneratedTablesShouldMatchFreshlyBuiltOnes();
 }   
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "debug.h"
 #include "magic_tdd.h"
+#include "lookup.h"
 
 enum {
     corner_rook_index_bits = 12,
@@ -31,6 +32,10 @@ static MagicEntry_t rMagicEntries[NUM_SQUARES];
 static MagicEntry_t bMagicEntries[NUM_SQUARES];
 static Bitboard_t hashTable[NUM_HASH_ENTRIES];
 
+static MagicEntry_t rPextEntries[NUM_SQUARES];
+static MagicEntry_t bPextEntries[NUM_SQUARES];
+static Bitboard_t pextTable[NUM_HASH_ENTRIES];
+
 // HELPERS
 static bool SquareIsCorner(Square_t square) {
     return CreateBitboard(1, square) & (CreateBitboard(4, a1,a8,h1,h8));
@@ -130,6 +135,61 @@ static void TestQueenHashLookup(MagicEntry_t rMagicEntries[NUM_SQUARES], MagicEn
     PrintResults(queen_attacks == queen_expected_attacks);
 }
 
+// every blocker subset of every square has to give the same attacks whichever way the table is indexed
+static bool BackendsAgreeOnEntries(MagicEntry_t magicEntries[NUM_SQUARES], MagicEntry_t pextEntries[NUM_SQUARES]) {
+    for(Square_t square = 0; square < NUM_SQUARES; square++) {
+        Bitboard_t mask = magicEntries[square].mask;
+        if(mask != pextEntries[square].mask) {
+            return false;
+        }
+
+        Bitboard_t blockers = 0;
+        do {
+            Bitboard_t magicAttacks = FindSlidingAttackSetInHashTable(magicEntries[square], blockers, hashTable);
+            Bitboard_t pextAttacks = FindSlidingAttackSetWithPext(pextEntries[square], blockers, pextTable);
+            if(magicAttacks != pextAttacks) {
+                return false;
+            }
+
+            blockers = (blockers - mask) & mask;
+        } while(blockers);
+    }
+
+    return true;
+}
+
+// whichever backend and tables the engine ended up with, its attacks have to match a magic table built just now
+static void EngineLookupMatchesFreshMagics() {
+    bool success = true;
+    for(Square_t square = 0; square < NUM_SQUARES; square++) {
+        Bitboard_t rookBlockers = 0;
+        do {
+            Bitboard_t expected = FindSlidingAttackSetInHashTable(rMagicEntries[square], rookBlockers, hashTable);
+            success = success && (GetRookAttackSet(square, ~rookBlockers) == expected);
+            rookBlockers = (rookBlockers - rMagicEntries[square].mask) & rMagicEntries[square].mask;
+        } while(rookBlockers);
+
+        Bitboard_t bishopBlockers = 0;
+        do {
+            Bitboard_t expected = FindSlidingAttackSetInHashTable(bMagicEntries[square], bishopBlockers, hashTable);
+            success = success && (GetBishopAttackSet(square, ~bishopBlockers) == expected);
+            bishopBlockers = (bishopBlockers - bMagicEntries[square].mask) & bMagicEntries[square].mask;
+        } while(bishopBlockers);
+    }
+
+    PrintResults(success);
+}
+
+static void PextMatchesMagics() {
+    InitAllPextEntries(rPextEntries, bPextEntries, pextTable);
+
+    bool success =
+        BackendsAgreeOnEntries(rMagicEntries, rPextEntries) &&
+        BackendsAgreeOnEntries(bMagicEntries, bPextEntries);
+
+    PrintResults(success);
+}
+
 void MagicTDDRunner() {
     InitAllMagicEntries(
         rMagicEntries,
@@ -145,4 +205,10 @@ void MagicTDDRunner() {
     TestRookHashLookup(rMagicEntries);
     TestBishopHashLookup(bMagicEntries);
     TestQueenHashLookup(rMagicEntries, bMagicEntries);
+    EngineLookupMatchesFreshMagics();
+
+    // can't run the instruction to compare against on a CPU without it
+    if(CpuSupportsPext()) {
+        PextMatchesMagics();
+    }
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "game_state.h"
 #include "board_info.h"
 #include "debug.h"
+#include "FEN.h"
+#include "evaluation.h"
 
 enum {
     some_halfmove_clock = 32
@@ -15,6 +17,13 @@ static void TestSetup() {
     InitGameStack(&stack);
 }
 
+// without UNDO_UNMAKE, unmaking reads the board back off the stack, so the starting board has to be stored there too
+static void SaveStartingBoard(GameState_t* state, BoardInfo_t* info) {
+#ifndef UNDO_UNMAKE
+    state->boardInfo = *info;
+#endif
+}
+
 static void MakeMoveTestWrapper(BoardInfo_t* info, GameStack_t* gameStack, Move_t move, Color_t color) {
     info->colorToMove = color;
     MakeMove(info, gameStack, move);
@@ -31,7 +40,7 @@ static void InitAllCastlingLegalInfo(BoardInfo_t* info) {
     });
 
     AddStartingGameState(&stack);
-    stack.gameStates[stack.top].boardInfo = *info;
+    SaveStartingBoard(&stack.gameStates[stack.top], info);
 }
 
 // r3k2r/8/8/8/8/8/8/R4RK1
@@ -76,7 +85,7 @@ static void InitPromotionPostionInfo(BoardInfo_t* info) {
     });
 
     AddStartingGameState(&stack);
-    stack.gameStates[stack.top].boardInfo = *info;
+    SaveStartingBoard(&stack.gameStates[stack.top], info);
 }
 
 // 8/4P3/7K/8/8/7k/2p5/1Q6
@@ -127,7 +136,7 @@ static void InitBothSidesEnPassantInfo(BoardInfo_t* info) {
     state->castleSquares[black] = empty_set;
     state->enPassantSquare = CreateBitboard(2, c3,h6);
     state->capturedPiece = none_type;
-    state->boardInfo = *info;
+    SaveStartingBoard(state, info);
 }
 
 static void InitSideEnPassantExpectedInfo(BoardInfo_t* expectedInfo, GameState_t* expectedState, Color_t moveColor) {
@@ -176,7 +185,7 @@ static void InitNormalPosition(BoardInfo_t* info) {
     state->castleSquares[white] = empty_set;
     state->castleSquares[black] = empty_set;
     state->capturedPiece = none_type;
-    state->boardInfo = *info;
+    SaveStartingBoard(state, info);
 }
 
 static void InitNormalQuietExpected(BoardInfo_t* expectedInfo, GameState_t* expectedState) {
@@ -244,7 +253,7 @@ static void InitBreakCastlingPosition(BoardInfo_t* info) {
     InitAllCastlingLegalInfo(info);
     info->bishops[black] = CreateBitboard(1, f6);
     AddPieceToMailbox(info, f6, bishop);
-    stack.gameStates[stack.top].boardInfo = *info;
+    SaveStartingBoard(&stack.gameStates[stack.top], info);
 }
 
 static void InitBreakCastlingPositionExpected(BoardInfo_t* expectedInfo, GameState_t* expectedState) {
@@ -280,7 +289,7 @@ static void InitPromotionCastleBreakPosition(BoardInfo_t* info) {
     state->enPassantSquare = empty_set;
     state->castleSquares[white] = empty_set;
     state->castleSquares[black] = CreateBitboard(1, c8);
-    state->boardInfo = *info;
+    SaveStartingBoard(state, info);
     state->capturedPiece = none_type;
 }
 
@@ -550,6 +559,75 @@ static void PromotionCaptureShouldRemoveCastleSquares() {
     PrintResults(infoMatches && stateMatches);
 }
 
+static void NullMoveShouldPassTurnAndClearEnPassant() {
+    TestSetup();
+    BoardInfo_t info;
+    InitNormalPosition(&info);
+
+    Move_t doublePush;
+    InitMove(&doublePush);
+    WriteFromSquare(&doublePush, f2);
+    WriteToSquare(&doublePush, f4);
+    MakeMoveTestWrapper(&info, &stack, doublePush, white);
+
+    BoardInfo_t expectedInfo = info;
+    GameState_t expectedState = ReadDefaultNextGameState(&stack);
+    expectedState.halfmoveClock = 0;
+
+    MakeNullMove(&info, &stack);
+
+    bool infoMatches = CompareInfo(&info, &expectedInfo);
+    bool stateMatches = CompareState(&expectedState, &stack);
+    bool colorFlipped = info.colorToMove == white;
+#ifndef UNDO_UNMAKE
+    colorFlipped = colorFlipped && ReadCurrentBoardInfo(&stack).colorToMove == white;
+#endif
+
+    PrintResults(infoMatches && stateMatches && colorFlipped);
+}
+
+static bool MaterialAndPSTStaysUpToDate(BoardInfo_t* info, int depth) {
+    BoardInfo_t recomputed = *info;
+    InitMaterialAndPST(&recomputed);
+    if(recomputed.materialAndPST != info->materialAndPST || recomputed.phase != info->phase) {
+        return false;
+    }
+
+    if(depth == 0) {
+        return true;
+    }
+
+    MoveList_t moveList;
+    CompleteMovegen(&moveList, info, &stack);
+
+    bool success = true;
+    for(int i = 0; i <= moveList.maxIndex; i++) {
+        MakeMove(info, &stack, moveList.moves[i]);
+        success = success && MaterialAndPSTStaysUpToDate(info, depth - 1);
+        UnmakeMove(info, &stack);
+    }
+
+    return success;
+}
+
+static void ShouldKeepMaterialAndPSTUpToDate() {
+    FEN_t fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbqkb1r/pp1p1ppp/5n2/2pPp3/8/8/PPP1PPPP/RNBQKBNR w KQkq c6 0 4",
+    };
+
+    bool success = true;
+    for(int i = 0; i < 3; i++) {
+        BoardInfo_t info;
+        ZobristStack_t zobristStack;
+        InterpretFEN(fens[i], &info, &stack, &zobristStack);
+        success = success && MaterialAndPSTStaysUpToDate(&info, 3);
+    }
+
+    PrintResults(success);
+}
+
 void MakeMoveTDDRunner() {
     ShouldCastleKingside();
     ShouldCastleQueenside();
@@ -567,6 +645,10 @@ void MakeMoveTDDRunner() {
 
     CapturingRookShouldRemoveCastleSquares();
     PromotionCaptureShouldRemoveCastleSquares();
+
+    NullMoveShouldPassTurnAndClearEnPassant();
+
+    ShouldKeepMaterialAndPSTUpToDate();
 }
 
 // UMAKE HELPERS
@@ -700,6 +782,23 @@ static void ShouldUnmakeNormalCaptures() {
     PrintResults(GenericTestUnmake(&info, move, black));
 }
 
+static void ShouldUnmakeNullMove() {
+    TestSetup();
+    BoardInfo_t info;
+    InitNormalPosition(&info);
+
+    BoardInfo_t expectedInfo = info;
+    GameState_t originalState = ReadCurrentGameState(&stack);
+
+    MakeNullMove(&info, &stack);
+    UnmakeNullMove(&info, &stack);
+
+    bool infoMatches = CompareInfo(&info, &expectedInfo);
+    bool stateMatches = CompareState(&originalState, &stack);
+
+    PrintResults(infoMatches && stateMatches);
+}
+
 void UnmakeMoveTDDRunner() {
     ShouldCastleKingsideUnmake();
     ShouldCastleQueensideUnmake();
@@ -712,4 +811,6 @@ void UnmakeMoveTDDRunner() {
 
     ShouldUnmakeNormalQuietMoves();
     ShouldUnmakeNormalCaptures();
+
+    ShouldUnmakeNullMove();
 }
\ No newline at end of file
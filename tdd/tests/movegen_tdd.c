@@ -9,9 +9,19 @@
 #include "lookup.h"
 #include "move.h"
 #include "game_state.h"
+#include "make_and_unmake.h"
+#include "zobrist.h"
+#include "perft_table.h"
+#include "util_macros.h"
+
+enum {
+    split_perft_depth = 3,
+    quiet_check_depth = 2
+};
 
 // HELPERS
 static GameStack_t stack;
+static ZobristStack_t zobristStack;
 
 static void TestSetup() {
     InitGameStack(&stack);
@@ -40,6 +50,116 @@ static int CountPieceMoves(Piece_t piece, MoveList_t moveList, BoardInfo_t* info
     return count;
 }
 
+static bool IsCaptureOrQueenPromotion(BoardInfo_t* info, Move_t move) {
+    SpecialFlag_t flag = ReadSpecialFlag(move);
+    if(flag == promotion_flag) {
+        return ReadPromotionPiece(move) == queen;
+    }
+
+    return flag == en_passant_flag || PieceOnSquare(info, ReadToSquare(move)) != none_type;
+}
+
+// Walks the tree with the generators the search uses, and counts any move that ended up in the wrong pass.
+static PerftCount_t SplitGeneratorPerft(BoardInfo_t* info, int depth, int* misplacedMoves) {
+    MovegenInfo_t movegenInfo;
+    DefineMovegenInfo(&movegenInfo, info);
+
+    MoveList_t moveList;
+    moveList.maxIndex = movelist_empty;
+    if(movegenInfo.inCheck) {
+        GenerateEvasions(&moveList, info, &stack, &movegenInfo);
+    } else {
+        GenerateCaptures(&moveList, info, &stack, &movegenInfo);
+        GenerateQuiets(&moveList, info, &stack, &movegenInfo);
+    }
+
+    for(int i = 0; i <= moveList.maxIndex; i++) {
+        bool inCapturePass = i <= moveList.maxCapturesIndex;
+        if(IsCaptureOrQueenPromotion(info, moveList.moves[i]) != inCapturePass) {
+            (*misplacedMoves)++;
+        }
+    }
+
+    if(depth == 1) {
+        return moveList.maxIndex + 1;
+    }
+
+    PerftCount_t count = 0;
+    for(int i = 0; i <= moveList.maxIndex; i++) {
+        MakeMove(info, &stack, moveList.moves[i]);
+        count += SplitGeneratorPerft(info, depth-1, misplacedMoves);
+        UnmakeMove(info, &stack);
+    }
+
+    return count;
+}
+
+static bool MoveGivesCheck(BoardInfo_t* info, Move_t move) {
+    MakeMove(info, &stack, move);
+    Color_t enemy = info->colorToMove;
+    bool givesCheck = InCheck(info->kings[enemy], UnsafeSquares(info, enemy));
+    UnmakeMove(info, &stack);
+
+    return givesCheck;
+}
+
+static bool ListContainsMove(MoveList_t* moveList, Move_t move) {
+    for(int i = 0; i <= moveList->maxIndex; i++) {
+        if(moveList->moves[i].data == move.data) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Every quiet move that isn't castling or a promotion gets made to see whether it checks, and has to be
+// in the quiet checks exactly when it does. Returns the number of moves that disagree.
+static int CountQuietCheckMismatches(BoardInfo_t* info, int depth) {
+    MoveList_t moveList;
+    CompleteMovegen(&moveList, info, &stack);
+
+    MovegenInfo_t movegenInfo;
+    DefineMovegenInfo(&movegenInfo, info);
+
+    int mismatches = 0;
+    if(!movegenInfo.inCheck) {
+        MoveList_t quietChecks;
+        quietChecks.maxIndex = movelist_empty;
+        GenerateQuietChecks(&quietChecks, info, &stack, &movegenInfo);
+
+        int numFound = 0;
+        for(int i = moveList.maxCapturesIndex + 1; i <= moveList.maxIndex; i++) {
+            Move_t move = moveList.moves[i];
+            SpecialFlag_t flag = ReadSpecialFlag(move);
+            if(flag == castle_flag || flag == promotion_flag || !MoveGivesCheck(info, move)) {
+                continue;
+            }
+
+            if(ListContainsMove(&quietChecks, move)) {
+                numFound++;
+            } else {
+                mismatches++;
+            }
+        }
+
+        // anything left over isn't a quiet check, or is in there twice
+        mismatches += (quietChecks.maxIndex + 1) - numFound;
+    }
+
+    if(depth == 1) {
+        return mismatches;
+    }
+
+    for(int i = 0; i <= moveList.maxIndex; i++) {
+        MakeMove(info, &stack, moveList.moves[i]);
+        mismatches += CountQuietCheckMismatches(info, depth-1);
+        UnmakeMove(info, &stack);
+    }
+
+    return mismatches;
+}
+
 // q5bk/1P6/2P1Q3/3K2Rr/8/3N1B2/3n4/3r4
 static void InitPinPositionInfo(BoardInfo_t* info) {
     InitTestInfo(info, {
@@ -67,7 +187,7 @@ static void ShouldCorrectlyEvaluateCapturesInPosWithPins() {
     InitPinPositionInfo(&info);
 
     int expectedNumKingCaptures = 0;
-    int expectedNumPawnCaptures = 4;
+    int expectedNumPawnCaptures = 2; // bxa8=Q and b8=Q, the underpromotions are generated with the quiets
     int expectedNumRookCaptures = 1;
     int expectedNumBishopCaptures = 2;
     int expectedNumKnightsCaptures = 0;
@@ -83,7 +203,7 @@ static void ShouldCorrectlyEvaluateCapturesInPosWithPins() {
         (CountPieceMoves(bishop, moveList, &info) == expectedNumBishopCaptures) &&
         (CountPieceMoves(knight, moveList, &info) == expectedNumKnightsCaptures) &&
         (CountPieceMoves(queen, moveList, &info) == expectedNumQueenCaptures) &&
-        moveList.maxIndex == 7;
+        moveList.maxIndex == 5;
 
     PrintResults(success);
 }
@@ -123,7 +243,66 @@ static void ShouldCorrectlyEvaluateInPosWithPins() {
     PrintResults(success);
 }
 
+// captures, quiets and evasions have to add up to the same tree the complete generator gives
+static void SplitGeneratorsShouldMatchPerftCounts() {
+    PerftTestContainer_t table[NUM_PERFT_ENTRIES] = {
+        PERFT_TEST_TABLE(EXPAND_AS_TEST_CONTAINER)
+    };
+
+    bool success = true;
+    int misplacedMoves = 0;
+    for(int i = 0; i < NUM_PERFT_ENTRIES; i++) {
+        PerftCount_t expectedCount = table[i].expectedCounts[split_perft_depth - 1];
+        if(expectedCount == 0) { // not every entry has counts for every depth
+            continue;
+        }
+
+        TestSetup();
+        BoardInfo_t info;
+        InterpretFEN(table[i].fen, &info, &stack, &zobristStack);
+
+        PerftCount_t count = SplitGeneratorPerft(&info, split_perft_depth, &misplacedMoves);
+        success = success && (count == expectedCount);
+    }
+
+    PrintResults(success && misplacedMoves == 0);
+}
+
+static void QuietChecksShouldMatchMakingEveryQuietMove() {
+    PerftTestContainer_t table[NUM_PERFT_ENTRIES] = {
+        PERFT_TEST_TABLE(EXPAND_AS_TEST_CONTAINER)
+    };
+
+    // discoveries by a knight, a pawn and the king, which the perft positions hardly ever have
+    FEN_t discoveryFens[] = {
+        "4k3/8/8/4N3/8/8/4R3/4K3 w - - 0 1",
+        "7k/8/8/4P3/8/2B5/8/K7 w - - 0 1",
+        "k7/8/8/8/8/K7/8/R7 w - - 0 1",
+    };
+
+    int mismatches = 0;
+    for(int i = 0; i < NUM_PERFT_ENTRIES; i++) {
+        TestSetup();
+        BoardInfo_t info;
+        InterpretFEN(table[i].fen, &info, &stack, &zobristStack);
+
+        mismatches += CountQuietCheckMismatches(&info, quiet_check_depth);
+    }
+
+    for(int i = 0; i < NUM_ARRAY_ELEMENTS(discoveryFens); i++) {
+        TestSetup();
+        BoardInfo_t info;
+        InterpretFEN(discoveryFens[i], &info, &stack, &zobristStack);
+
+        mismatches += CountQuietCheckMismatches(&info, quiet_check_depth);
+    }
+
+    PrintResults(mismatches == 0);
+}
+
 void MovegenTDDRunner() {
     ShouldCorrectlyEvaluateCapturesInPosWithPins();
     ShouldCorrectlyEvaluateInPosWithPins();
+    SplitGeneratorsShouldMatchPerftCounts();
+    QuietChecksShouldMatchMakingEveryQuietMove();
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "game_state.h"
 #include "UCI.h"
 #include "make_and_unmake.h"
+#include "movegen.h"
 
 static FEN_t someFen = "1k4r1/p2n1p2/Pp1p4/3P4/1RPr3p/6P1/5P1P/R4K2 b - - 1 26";
 static BoardInfo_t info;
@@ -30,6 +31,36 @@ static ZobristHash_t GetHashFromSeriesOfMoves(FEN_t fen, const char* moveSet[4])
     return HashPosition(&info, &gameStack);
 }
 
+static bool IncrementalHashMatchesFullHash(int depth) {
+    if(ReadZobristHash(&gameStack) != HashPosition(&info, &gameStack)) {
+        return false;
+    }
+
+    if(ReadPawnHash(&gameStack) != HashPawnStructure(&info)) {
+        return false;
+    }
+
+    if(depth == 0) {
+        return true;
+    }
+
+    bool matches = true;
+
+    MakeNullMove(&info, &gameStack);
+    matches = matches && (ReadZobristHash(&gameStack) == HashPosition(&info, &gameStack));
+    UnmakeNullMove(&info, &gameStack);
+
+    MoveList_t moveList;
+    CompleteMovegen(&moveList, &info, &gameStack);
+    for(int i = 0; i <= moveList.maxIndex; i++) {
+        MakeMove(&info, &gameStack, moveList.moves[i]);
+        matches = matches && IncrementalHashMatchesFullHash(depth - 1);
+        UnmakeMove(&info, &gameStack);
+    }
+
+    return matches;
+}
+
 // TESTS
 static void ShouldGenerateNonZeroHash() {
     InterpretFEN(someFen, &info, &gameStack, &zobristStack);
@@ -84,8 +115,26 @@ static void ShouldGenerateDifferentHashesForDifferentPositions() {
     PrintResults(hash1 != hash2);
 }
 
+static void IncrementalHashShouldMatchFullHash() {
+    FEN_t fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbqkb1r/pp1p1ppp/5n2/2pPp3/8/8/PPP1PPPP/RNBQKBNR w KQkq c6 0 4",
+    };
+
+    bool success = true;
+    for(int i = 0; i < 4; i++) {
+        InterpretFEN(fens[i], &info, &gameStack, &zobristStack);
+        success = success && IncrementalHashMatchesFullHash(3);
+    }
+
+    PrintResults(success);
+}
+
 void ZobristTDDRunner() {
     ShouldGenerateNonZeroHash();
     ShouldGenerateSameHashesForSamePositions();
     ShouldGenerateDifferentHashesForDifferentPositions();
+    IncrementalHashShouldMatchFullHash();
 }
\ No newline at end of file
@@ -48,7 +48,12 @@ $(ENDINGS)\endings.c \
 $(ENGINE)\chess_search.c \
 $(ENGINE)\evaluation.c \
 $(ENGINE)\PV_table.c \
+$(ENGINE)\SEE.c \
+$(ENGINE)\pawn_structure.c \
+$(ENGINE)\NNUE.c \
 $(ENGINE)\move_ordering.c \
+$(ENGINE)\move_picker.c \
+$(ENGINE)\transposition_table.c \
 $(FEN)\FEN.c \
 $(LOOKUP)\lookup.c \
 $(PLAY)\move.c \
@@ -90,23 +95,37 @@ $(TDD)\endings_tdd.c \
 $(ENGINE_TDD)\basic_tests.c \
 $(ENGINE_TDD)\PV_table_tdd.c \
 $(ENGINE_TDD)\random_crashes.c \
-$(ENGINE_TDD)\move_ordering_tdd.c
+$(ENGINE_TDD)\move_ordering_tdd.c \
+$(ENGINE_TDD)\move_picker_tdd.c \
+$(ENGINE_TDD)\SEE_tdd.c \
+$(ENGINE_TDD)\pawn_structure_tdd.c \
+$(ENGINE_TDD)\NNUE_tdd.c \
+$(ENGINE_TDD)\transposition_table_tdd.c
 
 D_OBJECTS=$(D_CFILES:%.c=%.o)
 
 EXE=bin
 DEBUG_EXE=debug
 
+GENERATOR=table_generator
+GENERATED_TABLES=$(LOOKUP)\lookup_tables.h $(ZOBRIST)\zobrist_keys.h
+
 all: $(EXE) $(DEBUG_EXE)
 
 test: $(DEBUG_EXE)
 	$(DEBUG_EXE)
 
 $(EXE): $(OBJECTS)
-	$(CC) $(CFLAGS) -o $@ $^
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
 
 $(DEBUG_EXE): $(D_OBJECTS)
-	$(CC) $(CFLAGS) -o $@ $^
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+# The generator builds every table at runtime, so it compiles its own RUNTIME_TABLES copy of the
+# sources instead of sharing their objects. Its output is checked in, only rerun it when a table changes.
+tables:
+	$(CC) $(CFLAGS) -DRUNTIME_TABLES $(CPPFLAGS) -o $(GENERATOR) $(GENERATOR).c $(COMMON_CFILES) $(LDLIBS)
+	$(GENERATOR) $(GENERATED_TABLES)
 
 %.o: %.c
 	$(CC) $(CFLAGS) $(CPPFLAGS) -c -o $@ $^